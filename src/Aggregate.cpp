@@ -24,9 +24,15 @@
 
 void
 Aggregate::reset(
-    const Solver& solver )
+    Solver& solver )
 {    
     trace_msg( aggregates, 2, "Calling reset for aggregate " << *this );        
+    if( !subset.empty() )
+    {
+        resetWatchedSubset( solver );
+        return;
+    }
+    
     if( trail.empty() || ( !solver.isUndefined( literals[ abs( trail.back() ) ] ) && solver.getDecisionLevel( literals[ abs( trail.back() ) ] ) != 0 ) )
         return;    
 
@@ -92,10 +98,13 @@ Aggregate::onLiteralFalse(
     }
     assert( counter >= ( int64_t ) weights[ index ] );
     counter -= weights[ index ];
-    watched[ index ] = false;
+    count( index );
     
     if( solver.getDecisionLevel( currentLiteral ) != 0 )
-        trail.push_back( position );
+        pushInTrail( solver, position );
+    
+    if( !subset.empty() )
+        extendWatchedSubset( solver, position > 0 ? 0 : 1 );
 
     trace_msg( aggregates, 2, "Umax: " << umax << " - size: " << size() );
     while( umax < literals.size() && ( int64_t ) weights[ umax ] > counter )
@@ -109,7 +118,7 @@ Aggregate::onLiteralFalse(
             if( !solver.isTrue( lit ) )
             {                
                 //Maybe we don't need to add the position of this literal
-                trail.push_back( umax * ac );
+                pushInTrail( solver, umax * ac );
             
                 trace_msg( aggregates, 9, "Inferring " << lit << " as true" );
 //                createClauseFromTrail( lit );
@@ -159,6 +168,7 @@ Aggregate::updateBound(
     uint64_t bound )
 {
     trace_msg( aggregates, 1, "Updating bound. New value: " << bound );
+    bound_ = bound;
     uint64_t sumOfWeights = 0;    
     for( unsigned int i = 2; i < weights.size(); i++ )
     {
@@ -178,7 +188,10 @@ Aggregate::updateBound(
 
     trace_msg( aggregates, 1, "Counters: " << counterW1 << "," << counterW2 );
     weights[ 1 ] = w;
-        
+    
+    //Literals assigned at level 0 are counted again from scratch: the subsets are rebuilt afterwards.
+    vector< unsigned char > savedSubset;
+    subset.swap( savedSubset );
     for( unsigned int i = 2; i < weights.size(); i++ )
     {
         if( solver.getDecisionLevel( literals[ i ] ) != 0 )
@@ -194,10 +207,167 @@ Aggregate::updateBound(
 //            counterW2 -= weights[ i ];
         }
     }
+    subset.swap( savedSubset );
+    if( !subset.empty() )
+    {
+        while( trailLevels.size() < trail.size() )
+            trailLevels.push_back( 0 );
+        updateWatchedSubset( solver );
+    }
     trace_msg( aggregates, 1, "Counters final: " << counterW1 << "," << counterW2 );
     return ( sumOfWeights >= bound );
 }
 
+void
+Aggregate::pushInTrail(
+    Solver& solver,
+    int position )
+{
+    trail.push_back( position );
+    if( !subset.empty() )
+        trailLevels.push_back( solver.getCurrentDecisionLevel() );
+}
+
+void
+Aggregate::enableWatchedSubset(
+    Solver& solver )
+{
+    assert( subset.empty() );
+    assert( solver.getCurrentDecisionLevel() == 0 );
+    trace_msg( aggregates, 1, "Enabling watched subsets for aggregate " << *this );
+    subset.resize( literals.size(), 0 );
+    while( trailLevels.size() < trail.size() )
+        trailLevels.push_back( 0 );
+
+    //Otherwise the bound is not known yet: subsets are computed by updateBound.
+    if( weights[ 1 ] > 0 )
+        updateWatchedSubset( solver );
+}
+
+void
+Aggregate::updateWatchedSubset(
+    Solver& solver )
+{
+    assert( !subset.empty() );
+    assert( solver.getCurrentDecisionLevel() == 0 );
+    outside[ 0 ] = outside[ 1 ] = 0;
+    for( unsigned int i = 2; i < literals.size(); i++ )
+    {
+        if( !watched[ i ] )
+            continue;
+        for( unsigned int side = 0; side < 2; side++ )
+            if( !inSubset( i, side ) )
+                outside[ side ] += weights[ i ];
+    }
+
+    //A side whose aggregate literal is true at level 0 never infers anything.
+    if( !solver.isTrue( literals[ 1 ] ) && active != POS )
+        extendWatchedSubset( solver, 0 );
+    if( !solver.isFalse( literals[ 1 ] ) && active != NEG )
+        extendWatchedSubset( solver, 1 );
+    trace_msg( aggregates, 2, "Literals outside the subsets weight " << outside[ 0 ] << " and " << outside[ 1 ] );
+}
+
+void
+Aggregate::extendWatchedSubset(
+    Solver& solver,
+    unsigned int side )
+{
+    int64_t& counter = ( side == 0 ? counterW2 : counterW1 );
+    int64_t threshold = subsetThreshold();
+    unsigned int steps = literals.size() - 2;
+    while( outside[ side ] > 0 && counter - ( int64_t ) outside[ side ] < threshold && steps-- > 0 )
+    {
+        unsigned int index = cursor[ side ];
+        cursor[ side ] = ( index + 1 < literals.size() ? index + 1 : 2 );
+        if( !watched[ index ] || inSubset( index, side ) )
+            continue;
+
+        int position = ( side == 0 ? index : -index );
+        Literal lit = getFalseLiteral( position );
+        if( solver.isFalse( lit ) )
+        {
+            //Nobody notified this assignment: the literal is counted now, before any inference depending on it.
+            assert_msg( counter >= ( int64_t ) weights[ index ], "Literal " << lit << " in " << *this << " violates the aggregate" );
+            counter -= weights[ index ];
+            count( index );
+            if( solver.getDecisionLevel( lit ) != 0 )
+                pushInTrail( solver, position );
+        }
+        else
+        {
+            trace_msg( aggregates, 5, "Watching " << lit << " at position " << position );
+            subset[ index ] |= ( 1 << side );
+            outside[ side ] -= weights[ index ];
+            solver.addPropagator( lit, this, position );
+        }
+    }
+}
+
+void
+Aggregate::compactWatchedSubset(
+    Solver& solver,
+    unsigned int side )
+{
+    int64_t counter = ( side == 0 ? counterW2 : counterW1 );
+    int64_t threshold = subsetThreshold();
+    for( unsigned int index = literals.size() - 1; index >= 2; index-- )
+    {
+        if( !inSubset( index, side ) )
+            continue;
+        
+        //Literals false at level 0 are never needed again.
+        if( watched[ index ] )
+        {
+            if( counter - ( int64_t ) ( outside[ side ] + weights[ index ] ) < threshold )
+                continue;
+            outside[ side ] += weights[ index ];
+        }
+        
+        int position = ( side == 0 ? index : -index );
+        subset[ index ] &= ~( 1 << side );
+        solver.removePropagator( getFalseLiteral( position ), this, position );
+    }
+}
+
+void
+Aggregate::resetWatchedSubset(
+    Solver& solver )
+{
+    unsigned int level = solver.getCurrentDecisionLevel();
+    if( trailLevels.empty() || trailLevels.back() <= level )
+        return;
+
+    umax = 1;
+    assert( literalOfUnroll != Literal::null || active == 0 );
+    if( literalOfUnroll != Literal::null && solver.isUndefined( literalOfUnroll ) )
+    {
+        active = 0;
+        literalOfUnroll = Literal::null;
+    }
+
+    //Counted literals are popped by level: the ones counted late may still be false.
+    do
+    {
+        int last = trail.back();
+        unsigned int pos = abs( last );
+        trail.pop_back();
+        trailLevels.pop_back();
+        if( !watched[ pos ] )
+        {
+            ( last > 0 ) ? counterW2 += weights[ pos ] : counterW1 += weights[ pos ];
+            uncount( pos );
+        }
+    } while( !trailLevels.empty() && trailLevels.back() > level );
+    trace_msg( aggregates, 3, "Restored counters. Values: " << counterW1 << " - " << counterW2 );
+
+    if( trailLevels.empty() || trailLevels.back() == 0 )
+    {
+        compactWatchedSubset( solver, 0 );
+        compactWatchedSubset( solver, 1 );
+    }
+}
+
 unsigned int
 Aggregate::getLevelOfBackjump(
     const Solver& solver,
@@ -262,37 +432,98 @@ Aggregate::print( ostream& out ) const
 }
 
 void
-Aggregate::onLearning(
-    const Solver&,
-    Learning* strategy,
+Aggregate::computeReason(
     Literal lit )
 {
-//    for( int i = trail.size() - 1; i >= 0; i-- )
+    reason.clear();
+    
+    //Value of the counter of the active side when no literal of the trail was counted.
+    int64_t initialCounter = ( active == POS ? counterW1 : counterW2 );
+    for( unsigned int i = 0; i < trail.size(); i++ )
+    {
+        int position = trail[ i ];
+        int ac = ( position < 0 ? POS : NEG );
+        unsigned int index = ( position > 0 ? position : -position );
+        if( ac == active && !watched[ index ] )
+            initialCounter += weights[ index ];
+    }
+    
+    uint64_t weightOfLit = 0;
+    uint64_t sumOfReason = 0;
     for( unsigned int i = 0; i < trail.size(); i++ )
     {
         int position = trail[ i ];
-        
         int ac = ( position < 0 ? POS : NEG );
         
         unsigned int index = ( position > 0 ? position : -position );
-        Literal l = literals[ index ];    
-        if( ac == active )
+        if( ac == active && !watched[ index ] )
         {
-            if( active == NEG )
-                l = l.getOppositeLiteral();
-
-            if( !watched[ index ] )
-            {
-//                assert_msg( solver.getDecisionLevel( l ) > 0, "Literal " << l << " has been inferred at the decision level 0" );
-//                clause->addLiteral( l.getOppositeLiteral() );   
-                strategy->onNavigatingLiteral( l.getOppositeLiteral() );                
-            }
-            
-            assert( l != lit );            
+            assert( ( active == NEG ? literals[ index ].getOppositeLiteral() : literals[ index ] ) != lit );
+            reason.push_back( index );
+            sumOfReason += weights[ index ];
         }
         
-        if( l.getVariable() == lit.getVariable() )
-            break;        
+        if( literals[ index ].getVariable() == lit.getVariable() )
+        {
+            if( ac != active && watched[ index ] )
+                weightOfLit = weights[ index ];
+            break;
+        }
+    }
+    
+    //The literal is inferred as soon as the counter is smaller than its weight.
+    if( weightOfLit == 0 || ( int64_t ) weightOfLit > initialCounter )
+        return;
+    uint64_t needed = initialCounter - weightOfLit + 1;
+    assert_msg( sumOfReason >= needed, "Reason of " << lit << " in " << *this << " is too weak" );
+    if( sumOfReason < needed )
+        return;
+    
+    //Keep the literals assigned first, in order to prefer low decision levels.
+    uint64_t sum = 0;
+    unsigned int j = 0;
+    while( sum < needed )
+    {
+        assert( j < reason.size() );
+        sum += weights[ reason[ j++ ] ];
+    }
+    reason.shrink( j );
+    
+    //Literals are sorted by weight: the lightest ones have the greatest indexes.
+    unsigned int lightest = 0;
+    for( unsigned int i = 1; i < reason.size(); i++ )
+        if( reason[ i ] > reason[ lightest ] )
+            lightest = i;
+    if( sum - weights[ reason[ lightest ] ] < needed )
+        return;
+    
+    //Remove redundant literals, starting from the lightest ones.
+    reason.sort( compareIndexes );
+    j = 0;
+    for( unsigned int i = 0; i < reason.size(); i++ )
+    {
+        if( sum - weights[ reason[ i ] ] >= needed )
+            sum -= weights[ reason[ i ] ];
+        else
+            reason[ j++ ] = reason[ i ];
+    }
+    reason.shrink( j );
+    trace_msg( aggregates, 5, "Reason of " << lit << " reduced to " << reason.size() << " literals" );
+}
+
+void
+Aggregate::onLearning(
+    const Solver&,
+    Learning* strategy,
+    Literal lit )
+{
+    computeReason( lit );
+    for( unsigned int i = 0; i < reason.size(); i++ )
+    {
+        Literal l = literals[ reason[ i ] ];
+        if( active == NEG )
+            l = l.getOppositeLiteral();
+        strategy->onNavigatingLiteral( l.getOppositeLiteral() );
     }
 }
 
@@ -303,34 +534,12 @@ Aggregate::onNavigatingForUnsatCore(
     unsigned int numberOfCalls,
     Literal lit )
 {
-    for( unsigned int i = 0; i < trail.size(); i++ )
+    computeReason( lit );
+    for( unsigned int i = 0; i < reason.size(); i++ )
     {
-        int position = trail[ i ];
-        
-        int ac = ( position < 0 ? POS : NEG );
-        
-        unsigned int index = ( position > 0 ? position : -position );
-        Literal l = literals[ index ];    
-        if( ac == active )
-        {
-            if( active == NEG )
-                l = l.getOppositeLiteral();
-            
-            if( !watched[ index ] )
-            {
-//                assert_msg( solver.getDecisionLevel( l ) > 0, "Literal " << l << " has been inferred at the decision level 0" );
-//                clause->addLiteral( l.getOppositeLiteral() );                
-//                toVisit.push_back( l ); //l.getOppositeLiteral() );
-                Var variable = l.getVariable();
-                if( solver.getDecisionLevel( variable ) > 0 )
-                    visited[ variable ] = numberOfCalls;                
-            }
-            
-            assert( l != lit );            
-        }
-        
-        if( l.getVariable() == lit.getVariable() )
-            break;        
+        Var variable = literals[ reason[ i ] ].getVariable();
+        if( solver.getDecisionLevel( variable ) > 0 )
+            visited[ variable ] = numberOfCalls;
     }
 }
 
@@ -340,30 +549,14 @@ Aggregate::onNavigatingLiteralForAllMarked(
     Learning* strategy,
     Literal lit )
 {
-    for( unsigned int i = 0; i < trail.size(); i++ )
+    computeReason( lit );
+    for( unsigned int i = 0; i < reason.size(); i++ )
     {
-        int position = trail[ i ];        
-        int ac = ( position < 0 ? POS : NEG );
-        
-        unsigned int index = ( position > 0 ? position : -position );
-        Literal l = literals[ index ];            
-        if( ac == active )
-        {
-            if( active == NEG )
-                l = l.getOppositeLiteral();
-        
-            if( !watched[ index ] )
-            {
-//                assert_msg( l.getDecisionLevel() > 0, "Literal " << l << " has been inferred at the decision level 0" );
-                if( !strategy->onNavigatingLiteralForAllMarked( l.getOppositeLiteral() ) )
-                    return false;
-            }
-            
-            assert( l != lit );            
-        }
-        
-        if( l.getVariable() == lit.getVariable() )
-            break;
+        Literal l = literals[ reason[ i ] ];
+        if( active == NEG )
+            l = l.getOppositeLiteral();
+        if( !strategy->onNavigatingLiteralForAllMarked( l.getOppositeLiteral() ) )
+            return false;
     }
     
     return true;
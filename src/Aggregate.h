@@ -39,6 +39,7 @@ using namespace std;
 class Aggregate : public Propagator, public Reason
 {
     friend ostream& operator<<( ostream& out, const Aggregate& aggregate );
+    friend class Snapshot;
     public:
         inline Aggregate();
         inline ~Aggregate() {}
@@ -54,6 +55,7 @@ class Aggregate : public Propagator, public Reason
         
         unsigned int getLevelOfBackjump( const Solver& solver, uint64_t bound );
         bool updateBound( Solver& solver, uint64_t bound );
+        inline uint64_t getBound() const { return bound_; }
         inline bool isTrue() const;        
         
         inline Literal operator[]( unsigned int idx ) const { assert_msg( ( idx > 0 && idx < literals.size() ), "Index is " << idx << " - literals: " << literals.size() ); return literals[ idx ]; }
@@ -61,7 +63,7 @@ class Aggregate : public Propagator, public Reason
 
 //        inline void setCounterW1( unsigned int value ){ counterW1 = value; }
 //        inline void setCounterW2( unsigned int value ){ counterW2 = value; }
-        virtual void reset( const Solver& solver );
+        virtual void reset( Solver& solver );
         
         virtual void onLearning( const Solver& solver, Learning* strategy, Literal lit );
         virtual bool onNavigatingLiteralForAllMarked( const Solver& solver, Learning* strategy, Literal lit );
@@ -69,6 +71,14 @@ class Aggregate : public Propagator, public Reason
         
         inline void sort() { mergesort( 2, literals.size() - 1 ); }                
         
+        /**
+         * Register only a subset of the literals of the aggregate.
+         * The subset of each side covers the slack plus the maximum weight,
+         * so that assignments of the other literals cannot cause inferences:
+         * they are taken into account when the subset must be extended.
+         */
+        void enableWatchedSubset( Solver& solver );
+        
     protected:
         virtual ostream& print( ostream& out ) const;
 
@@ -83,11 +93,40 @@ class Aggregate : public Propagator, public Reason
         
         int64_t counterW1;
         int64_t counterW2;
+        uint64_t bound_;
         
         unsigned int umax;
         Vector< int > trail;
         
         Literal literalOfUnroll;
+        
+        //Side 0 handles positive positions (false literals), side 1 negative positions (true literals).
+        vector< unsigned char > subset;
+        uint64_t outside[ 2 ];
+        unsigned int cursor[ 2 ];
+        Vector< unsigned int > trailLevels;
+        
+        //Positions of the literals explaining the last navigated inference.
+        Vector< unsigned int > reason;
+
+        inline Literal getFalseLiteral( int position ) const { return position > 0 ? literals[ position ] : literals[ -position ].getOppositeLiteral(); }
+        inline bool inSubset( unsigned int index, unsigned int side ) const { return subset.empty() || index == 1 || ( subset[ index ] & ( 1 << side ) ); }
+        inline int64_t subsetThreshold() const { return watched[ 1 ] ? weights[ 1 ] : ( literals.size() > 2 ? weights[ 2 ] : 0 ); }
+        void pushInTrail( Solver& solver, int position );
+        inline void count( unsigned int index );
+        inline void uncount( unsigned int index );
+        void updateWatchedSubset( Solver& solver );
+        void extendWatchedSubset( Solver& solver, unsigned int side );
+        void compactWatchedSubset( Solver& solver, unsigned int side );
+        void resetWatchedSubset( Solver& solver );
+        
+        /**
+         * Compute in reason a subset of the trail implying lit.
+         * Literals are taken in the order of assignment until the slack is exceeded,
+         * then the redundant ones are removed starting from the lightest.
+         */
+        void computeReason( Literal lit );
+        inline static int compareIndexes( unsigned int a, unsigned int b ) { return a > b; }
 
 //        void createClauseFromTrail( Literal lit );
         #ifndef NDEBUG
@@ -140,13 +179,35 @@ class Aggregate : public Propagator, public Reason
         }
 };
 
-Aggregate::Aggregate() : Propagator(), active( 0 ), counterW1( 0 ), counterW2( 0 ), umax( 1 ), literalOfUnroll( Literal::null )
+Aggregate::Aggregate() : Propagator(), active( 0 ), counterW1( 0 ), counterW2( 0 ), bound_( 0 ), umax( 1 ), literalOfUnroll( Literal::null )
 {
+    outside[ 0 ] = outside[ 1 ] = 0;
+    cursor[ 0 ] = cursor[ 1 ] = 2;
     literals.push_back( Literal::null );
     weights.push_back( 0 );    
     watched.push_back( false );
 }
 
+void
+Aggregate::count(
+    unsigned int index )
+{
+    watched[ index ] = false;
+    for( unsigned int side = 0; side < 2; side++ )
+        if( !inSubset( index, side ) )
+            outside[ side ] -= weights[ index ];
+}
+
+void
+Aggregate::uncount(
+    unsigned int index )
+{
+    watched[ index ] = true;
+    for( unsigned int side = 0; side < 2; side++ )
+        if( !inSubset( index, side ) )
+            outside[ side ] += weights[ index ];
+}
+
 bool
 Aggregate::isTrue() const
 {
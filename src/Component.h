@@ -47,6 +47,7 @@ using namespace std;
 class Component : public PostPropagator
 {
     friend ostream& operator<<( ostream& o, const Component& c );
+    friend class Snapshot;
     public:
         inline Component( vector< GUSData* >& gusData_, Solver& s ) : PostPropagator(), solver( s ), gusData( gusData_ ), clauseToPropagate( NULL ), conflict( 0 ), id( 0 ), done( 0 ), first( 1 ), removed( 0 ), numberOfCalls( 0 ) {}
         ~Component();        
@@ -28,6 +28,7 @@ class Clause;
 
 class GUSData
 {
+    friend class Snapshot;
     public:
         inline GUSData();
         ~GUSData();
@@ -21,7 +21,7 @@ HCComponent::HCComponent(
     vector< GUSData* >& gusData_,
     Solver& s,
     unsigned numberOfInputAtoms ) : PostPropagator(), gusData( gusData_ ), solver( s ), numberOfCalls( 0 ), 
-        hasToTestModel( false ), numberOfAtoms( numberOfInputAtoms ), 
+        hasToTestModel( false ), checked( false ), numberOfAtoms( numberOfInputAtoms ), 
         id( 0 ), assumptionLiteral( Literal::null ), isConflictual( false ),
         numberOfExternalLiterals( 0 ), numberOfInternalVariables( 0 ), numberOfZeroLevel( 0 ), removedHCVars( 0 ), literalToAdd( Literal::null ),
         low( 0 ), high( solver.numberOfVariables() )
@@ -105,6 +105,7 @@ HCComponent::reset()
     }
 
     unfoundedSet.clear();
+    checked = false;
 }
 
 bool
@@ -285,15 +286,26 @@ HCComponent::addClauseToChecker(
     checker.addClause( c );    
 }
 
+void
+HCComponent::testModelConcurrently()
+{
+    assert( hasToBeChecked() );
+    assert( unfoundedSet.empty() );
+    testModel();
+    checked = true;
+}
+
 Clause*
 HCComponent::getClauseToPropagate(
     Learning& learning )
 {
-    assert( unfoundedSet.empty() );
-    if( hasToTestModel )
+    assert( checked || unfoundedSet.empty() );
+    if( hasToTestModel && !checked )
         testModel();
 
     hasToTestModel = false;
+    checked = false;
+    bumpActivityOfUnsatCore();
     if( !unfoundedSet.empty() )
     {
         trace_msg( modelchecker, 1, "Learning unfounded set rule for component " << *this );
@@ -535,7 +547,7 @@ void HCComponent::checkModel(
                     continue;
 
                 Literal origLit = getGeneratorLiteralFromCheckerLiteral( l );
-                solver.bumpActivity( origLit.getVariable() );
+                variablesToBump.push_back( origLit.getVariable() );
             }
         }
         checker.clearConflictStatus();        
@@ -545,6 +557,17 @@ void HCComponent::checkModel(
     checker.unrollToZero();    
 }
 
+void
+HCComponent::bumpActivityOfUnsatCore()
+{
+    //The check may run on a worker thread: the heuristic of the generator is updated here.
+    while( !variablesToBump.empty() )
+    {
+        solver.bumpActivity( variablesToBump.back() );
+        variablesToBump.pop_back();
+    }
+}
+
 void
 HCComponent::sendLearnedClausesToSolver()
 {
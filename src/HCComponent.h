@@ -60,6 +60,9 @@ class HCComponent : public PostPropagator
         GUSData& getGUSData( Var v ) { assert( v < gusData.size() ); return *( gusData[ v ] ); }
         void printLearnedClausesOfChecker() { checker.printLearnedClauses(); }
         void setHasToTestModel( bool b ) { hasToTestModel = b; }
+        bool hasToBeChecked() const { return hasToTestModel && !checked; }
+        void testModelConcurrently();
+        inline void discardConcurrentCheck() { if( checked ) { checked = false; unfoundedSet.clear(); } }
         
         void setId( unsigned int i ) { id = i; }
         unsigned int getId() const { return id; }
@@ -105,7 +108,9 @@ class HCComponent : public PostPropagator
         Vector< unsigned int > inUnfoundedSet;
         unsigned int numberOfCalls;
         
-        bool hasToTestModel;        
+        bool hasToTestModel;
+        bool checked;
+        Vector< Var > variablesToBump;
         
         unsigned int numberOfAtoms;
         unsigned int id;
@@ -124,6 +129,7 @@ class HCComponent : public PostPropagator
         unsigned int high;
         
         void testModel();
+        void bumpActivityOfUnsatCore();
         void computeAssumptions( vector< Literal >& assumptions );
         void iterationInternalLiterals( vector< Literal >& assumptions );
         void iterationExternalLiterals( vector< Literal >& assumptions );
@@ -54,6 +54,9 @@ MinisatHeuristic::makeAChoice()
     assert_msg( solver.isUndefined( chosenVariable ), "The literal must be undefined" );
     trace_msg( heuristic, 1, "Ending MiniSAT heuristic" );
 
+    if( chosenVariable < solutionPhases.size() && solutionPhases[ chosenVariable ] != UNDEFINED )
+        return solutionPhases[ chosenVariable ] == TRUE ? Literal( chosenVariable, POSITIVE ) : Literal( chosenVariable, NEGATIVE );
+
     //FIXME: Maybe in future we want to add the right minisat policy    
     if( solver.getCachedTruthValue( chosenVariable ) != UNDEFINED )
         return solver.getCachedTruthValue( chosenVariable ) == TRUE ? Literal( chosenVariable, POSITIVE ) : Literal( chosenVariable, NEGATIVE );
@@ -86,6 +89,15 @@ inline int irand( double& seed, int size) { return ( int )( drand( seed ) * size
 //    }
 //}
 
+void
+MinisatHeuristic::saveSolutionPhases()
+{
+    trace_msg( heuristic, 1, "Saving phases of the current model" );
+    solutionPhases.resize( solver.numberOfVariables() + 1, UNDEFINED );
+    for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+        solutionPhases[ v ] = solver.getTruthValue( v );
+}
+
 void
 MinisatHeuristic::simplifyVariablesAtLevelZero()
 {
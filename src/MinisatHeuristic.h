@@ -50,6 +50,7 @@ class MinisatHeuristic
         inline void variableDecayActivity(){ trace_msg( heuristic, 1, "Calling decay activity" ); variableIncrement *= variableDecay; }
         inline void addPreferredChoice( Literal lit ){ assert( lit != Literal::null ); preferredChoices.push_back( lit ); }
         inline void removePrefChoices() { preferredChoices.clear(); }
+        void saveSolutionPhases();
         void simplifyVariablesAtLevelZero();
         inline bool bumpActivity( Var var ){ assert( var < act.size() ); return ( ( act[ var ] += variableIncrement ) > 1e100 ); }        
         
@@ -64,6 +65,7 @@ class MinisatHeuristic
         
         Vector< Activity > act;
         vector< Literal > preferredChoices;
+        vector< TruthValue > solutionPhases;
         
         vector< Var > vars;
 
@@ -21,8 +21,11 @@
 #include "Solver.h"
 #include "util/Constants.h"
 
+#include <algorithm>
+#include <ctime>
+
 QueryInterface::QueryInterface(
-    Solver& s ) : solver( s )
+    Solver& s ) : solver( s ), brave( false ), groupSize( wasp::Options::queryChunkSize ), numberOfCalls( 0 ), numberOfCoherentCalls( 0 ), solvingTime( 0 ), maxCallTime( 0 )
 {
 }
 
@@ -35,6 +38,7 @@ QueryInterface::computeCautiousConsequences(
         solver.foundIncoherence();
         return;
     }
+    computeCandidates();
     
     switch( ALGORITHM )
     {            
@@ -45,12 +49,32 @@ QueryInterface::computeCautiousConsequences(
         case OVERESTIMATE_REDUCTION:
             overestimateReduction();
             break;
+
+        case CORE_BASED_CHUNKING:
+            coreBasedChunking();
+            break;
             
         default:
             ErrorMessage::errorGeneric( "Inserted invalid algorithm for query answering." );
     }
         
-    solver.printCautiousConsequences( answers );
+    solver.printConsequences( answers );
+    printStatistics();
+}
+
+void
+QueryInterface::computeBraveConsequences()
+{
+    brave = true;
+    if( !computeFirstModel() )
+    {
+        solver.foundIncoherence();
+        return;
+    }
+    computeBraveCandidates();
+    braveReasoning();
+    solver.printConsequences( answers );
+    printStatistics();
 }
 
 void
@@ -76,7 +100,7 @@ QueryInterface::iterativeCoherenceTesting()
         
         assert( solver.isUndefined( v ) );
         assumptions.push_back( Literal( v, NEGATIVE ) );
-        unsigned int result = solver.solve( assumptions );
+        unsigned int result = solve( assumptions );
         
         if( result == COHERENT )
             reduceCandidates();
@@ -106,7 +130,7 @@ QueryInterface::overestimateReduction()
     if( !solver.addClauseRuntime( clausePointer ) )
         return;
 
-    while( solver.solve() == COHERENT )
+    while( solve() == COHERENT )
     {
         if( size > 2 )
         {
@@ -132,15 +156,278 @@ QueryInterface::overestimateReduction()
     }
 }
 
+/*
+ * Candidates are the atoms not true in any model found so far. Each model is
+ * searched with a clause requiring one of the candidates to be true: the
+ * clause shrinks after each model and the previous one is removed.
+ */
+void
+QueryInterface::braveReasoning()
+{
+    solver.turnOffSimplifications();
+    Clause* clausePointer = NULL;
+    unsigned int size = 0;
+    while( true )
+    {
+        solver.unrollToZero();
+        assert( solver.getCurrentDecisionLevel() == 0 );
+        assert( !solver.conflictDetected() );
+
+        Clause* previous = clausePointer;
+        unsigned int previousSize = size;
+        clausePointer = computeClauseFromBraveCandidates();
+        size = clausePointer->size();
+        if( !solver.addClauseRuntime( clausePointer ) )
+            return;
+
+        if( previousSize > 2 )
+        {
+            assert( previous != NULL && previous->size() > 2 );
+            solver.detachClause( *previous );
+        }
+
+        if( solve() == INCOHERENT )
+            return;
+        reduceBraveCandidates();
+    }
+}
+
+/*
+ * The literals of all groups in the chunk are assumed: a model must falsify
+ * one candidate of each group, and removes all candidates it falsifies. An
+ * unsat core involving a single group shows that its candidates are answers.
+ * Groups sharing a core are merged, and tested as a whole by the next call.
+ * New groups are larger after confirmed groups, and smaller after models.
+ */
+void
+QueryInterface::coreBasedChunking()
+{
+    solver.turnOffSimplifications();
+    solver.setComputeUnsatCores( true );
+
+    vector< Literal > assumptions;
+    while( true )
+    {
+        solver.unrollToZero();
+        assert( solver.getCurrentDecisionLevel() == 0 );
+        assert( !solver.conflictDetected() );
+
+        //Auxiliary atoms of groups which changed are no longer used.
+        for( unsigned int i = 0; i < disabledAux.size(); i++ )
+            solver.addClauseRuntime( Literal( disabledAux[ i ], NEGATIVE ) );
+        disabledAux.clear();
+
+        normalizeChunk();
+        fillChunk();
+        if( groups.empty() )
+            break;
+
+        assumptions.clear();
+        for( unsigned int i = 0; i < groups.size(); i++ )
+            assumptions.push_back( getLiteralOfGroup( i ) );
+
+        groupOfVariable.resize( solver.numberOfVariables() + 1, MAXUNSIGNEDINT );
+        for( unsigned int i = 0; i < assumptions.size(); i++ )
+            groupOfVariable[ assumptions[ i ].getVariable() ] = i;
+
+        if( solve( assumptions ) == COHERENT )
+        {
+            reduceCandidates();
+            filterChunk();
+            if( groupSize > 1 )
+                groupSize /= 2;
+        }
+        else
+            analyzeCore();
+    }
+    solver.setComputeUnsatCores( false );
+}
+
+void
+QueryInterface::fillChunk()
+{
+    while( groups.size() < CORE_BASED_CHUNKING_GROUPS && !candidates.empty() )
+    {
+        vector< Var > group;
+        while( group.size() < groupSize && !candidates.empty() )
+        {
+            Var v = candidates.back();
+            candidates.pop_back();
+            if( solver.isUndefined( v ) )
+                group.push_back( v );
+            else if( solver.isTrue( v ) )
+            {
+                assert( solver.getDecisionLevel( v ) == 0 );
+                addAnswer( v );
+            }
+        }
+
+        if( group.empty() )
+            continue;
+        groups.push_back( group );
+        groupAux.push_back( 0 );
+    }
+    printCandidates();
+}
+
+void
+QueryInterface::normalizeChunk()
+{
+    assert( solver.getCurrentDecisionLevel() == 0 );
+    for( unsigned int i = 0; i < groups.size(); )
+    {
+        vector< Var >& group = groups[ i ];
+        unsigned int j = 0;
+        for( unsigned int k = 0; k < group.size(); k++ )
+        {
+            Var v = group[ j ] = group[ k ];
+            if( solver.isUndefined( v ) )
+                j++;
+            else if( solver.isTrue( v ) )
+                addAnswer( v );
+        }
+
+        if( j != group.size() )
+        {
+            group.resize( j );
+            disableGroupLiteral( i );
+        }
+
+        if( group.empty() )
+            removeGroup( i );
+        else
+            i++;
+    }
+}
+
+void
+QueryInterface::filterChunk()
+{
+    for( unsigned int i = 0; i < groups.size(); )
+    {
+        vector< Var >& group = groups[ i ];
+        unsigned int j = 0;
+        for( unsigned int k = 0; k < group.size(); k++ )
+        {
+            Var v = group[ j ] = group[ k ];
+            assert( !solver.isUndefined( v ) );
+            if( solver.isTrue( v ) )
+                j++;
+        }
+
+        assert( j < group.size() );
+        group.resize( j );
+        disableGroupLiteral( i );
+
+        if( group.empty() )
+            removeGroup( i );
+        else
+            i++;
+    }
+}
+
+void
+QueryInterface::analyzeCore()
+{
+    assert( solver.getUnsatCore() != NULL );
+    const Clause& core = *solver.getUnsatCore();
+    assert( core.size() > 0 );
+
+    vector< unsigned int > inCore;
+    for( unsigned int i = 0; i < core.size(); i++ )
+    {
+        unsigned int group = groupOfVariable[ core[ i ].getVariable() ];
+        assert( group < groups.size() );
+        if( find( inCore.begin(), inCore.end(), group ) == inCore.end() )
+            inCore.push_back( group );
+    }
+
+    vector< Var > merged;
+    for( unsigned int i = 0; i < inCore.size(); i++ )
+    {
+        vector< Var >& group = groups[ inCore[ i ] ];
+        if( inCore.size() == 1 )
+        {
+            for( unsigned int j = 0; j < group.size(); j++ )
+                addAnswer( group[ j ] );
+            if( groupSize < CORE_BASED_CHUNKING_MAX_GROUP_SIZE )
+                groupSize *= 2;
+        }
+        else
+            merged.insert( merged.end(), group.begin(), group.end() );
+        disableGroupLiteral( inCore[ i ] );
+        group.clear();
+    }
+
+    //Groups are removed from the back, so that positions in inCore are still valid.
+    sort( inCore.begin(), inCore.end() );
+    while( !inCore.empty() )
+    {
+        removeGroup( inCore.back() );
+        inCore.pop_back();
+    }
+
+    if( !merged.empty() )
+    {
+        groups.push_back( merged );
+        groupAux.push_back( 0 );
+    }
+}
+
+Literal
+QueryInterface::getLiteralOfGroup(
+    unsigned int group )
+{
+    assert( solver.getCurrentDecisionLevel() == 0 );
+    const vector< Var >& candidatesOfGroup = groups[ group ];
+    assert( !candidatesOfGroup.empty() );
+    if( candidatesOfGroup.size() == 1 )
+        return Literal( candidatesOfGroup[ 0 ], NEGATIVE );
+
+    if( groupAux[ group ] == 0 )
+    {
+        solver.addVariableRuntime();
+        Var aux = solver.numberOfVariables();
+        Clause* clause = new Clause();
+        clause->addLiteral( Literal( aux, NEGATIVE ) );
+        for( unsigned int i = 0; i < candidatesOfGroup.size(); i++ )
+            clause->addLiteral( Literal( candidatesOfGroup[ i ], NEGATIVE ) );
+        clause->setCanBeDeleted( false );
+        solver.addClauseRuntime( clause );
+        groupAux[ group ] = aux;
+    }
+    return Literal( groupAux[ group ], POSITIVE );
+}
+
+void
+QueryInterface::disableGroupLiteral(
+    unsigned int group )
+{
+    if( groupAux[ group ] == 0 )
+        return;
+    disabledAux.push_back( groupAux[ group ] );
+    groupAux[ group ] = 0;
+}
+
+void
+QueryInterface::removeGroup(
+    unsigned int group )
+{
+    assert( groups[ group ].empty() && groupAux[ group ] == 0 );
+    groups[ group ].swap( groups.back() );
+    groups.pop_back();
+    groupAux[ group ] = groupAux.back();
+    groupAux.pop_back();
+}
+
 bool
 QueryInterface::computeFirstModel()
 {
-    unsigned int result = solver.solve();
+    unsigned int result = solve();
     if( result == INCOHERENT )
         return false;
     
     assert( result == COHERENT );
-    computeCandidates();    
     return true;
 }
 
@@ -164,6 +451,41 @@ QueryInterface::computeCandidates()
     }
 }
 
+void
+QueryInterface::computeBraveCandidates()
+{
+    for( unsigned int i = 1; i <= solver.numberOfVariables(); i++ )
+    {
+        Var v = i;
+        if( VariableNames::isHidden( v ) )
+            continue;
+
+        assert_msg( !solver.hasBeenEliminated( v ), "Variable " << Literal( v, POSITIVE ) << " has been deleted" );
+        if( solver.isTrue( v ) )
+            addAnswer( v );
+        else if( solver.getDecisionLevel( v ) != 0 )
+            candidates.push_back( v );
+    }
+    printCandidates();
+}
+
+void
+QueryInterface::reduceBraveCandidates()
+{
+    unsigned int j = 0;
+    for( unsigned int i = 0; i < candidates.size(); i++ )
+    {
+        Var v = candidates[ j ] = candidates[ i ];
+        assert( !solver.isUndefined( v ) );
+        if( solver.isTrue( v ) )
+            addAnswer( v );
+        else
+            j++;
+    }
+    candidates.shrink( j );
+    printCandidates();
+}
+
 void
 QueryInterface::reduceCandidates()
 {
@@ -210,15 +532,78 @@ QueryInterface::computeClauseFromCandidates()
     return clause;
 }
 
+Clause*
+QueryInterface::computeClauseFromBraveCandidates()
+{
+    assert( solver.getCurrentDecisionLevel() == 0 );
+    Clause* clause = new Clause();
+    unsigned int j = 0;
+    for( unsigned int i = 0; i < candidates.size(); i++ )
+    {
+        Var v = candidates[ j ] = candidates[ i ];
+        //Candidates false at level 0 cannot be true in models satisfying the previous clause, hence in any model.
+        if( solver.isFalse( v ) )
+            continue;
+
+        assert( solver.isUndefined( v ) );
+        clause->addLiteral( Literal( v, POSITIVE ) );
+        j++;
+    }
+    candidates.shrink( j );
+    clause->setCanBeDeleted( false );
+    return clause;
+}
+
 void
 QueryInterface::addAnswer(
     Var v )
 {
     if( wasp::Options::queryVerbosity >= 1 )
-        cout << "Certain answer: " << Literal( v, POSITIVE ) << endl;
+        cout << ( brave ? "Brave answer: " : "Certain answer: " ) << Literal( v, POSITIVE ) << endl;
     answers.push_back( v );
 }
 
+unsigned int
+QueryInterface::solve()
+{
+    clock_t start = clock();
+    unsigned int result = solver.solve();
+    onSolved( result, double( clock() - start ) / CLOCKS_PER_SEC );
+    return result;
+}
+
+unsigned int
+QueryInterface::solve(
+    vector< Literal >& assumptions )
+{
+    clock_t start = clock();
+    unsigned int result = solver.solve( assumptions );
+    onSolved( result, double( clock() - start ) / CLOCKS_PER_SEC );
+    return result;
+}
+
+void
+QueryInterface::onSolved(
+    unsigned int result,
+    double time )
+{
+    numberOfCalls++;
+    if( result == COHERENT )
+        numberOfCoherentCalls++;
+    solvingTime += time;
+    if( time > maxCallTime )
+        maxCallTime = time;
+}
+
+void
+QueryInterface::printStatistics() const
+{
+    if( wasp::Options::queryVerbosity < 1 )
+        return;
+    cout << "Solver calls: " << numberOfCalls << " (" << numberOfCoherentCalls << " coherent)" << endl;
+    cout << "Solving time: " << solvingTime << "s (max " << maxCallTime << "s per call)" << endl;
+}
+
 void
 QueryInterface::printCandidates()
 {
@@ -19,9 +19,13 @@
 #ifndef QUERYINTERFACE_H
 #define	QUERYINTERFACE_H
 
+#include <vector>
 #include "stl/Vector.h"
+#include "util/Constants.h"
+using namespace std;
 
 class Clause;
+class Literal;
 class Solver;
 
 class QueryInterface
@@ -29,6 +33,12 @@ class QueryInterface
     public:
         QueryInterface( Solver& solver );
         void computeCautiousConsequences( unsigned int ALGORITHM );
+        void computeBraveConsequences();
+
+        inline unsigned int getNumberOfCalls() const { return numberOfCalls; }
+        inline unsigned int getNumberOfCoherentCalls() const { return numberOfCoherentCalls; }
+        inline double getSolvingTime() const { return solvingTime; }
+        inline double getMaxCallTime() const { return maxCallTime; }
 
     private:
         QueryInterface( const QueryInterface& orig );
@@ -38,19 +48,55 @@ class QueryInterface
         void enumerationOfModels();
         void iterativeCoherenceTesting();
         void overestimateReduction();
+        void coreBasedChunking();
         void computeCandidates();
         void reduceCandidates();
         
+        void braveReasoning();
+        void computeBraveCandidates();
+        void reduceBraveCandidates();
+        
         Clause* computeClauseFromCandidates();
+        Clause* computeClauseFromBraveCandidates();
         
         void addAnswer( Var v );
         
         void printCandidates();
+        void printStatistics() const;
+
+        unsigned int solve();
+        unsigned int solve( vector< Literal >& assumptions );
+        void onSolved( unsigned int result, double time );
+
+        void fillChunk();
+        void normalizeChunk();
+        void filterChunk();
+        void analyzeCore();
+        Literal getLiteralOfGroup( unsigned int group );
+        void disableGroupLiteral( unsigned int group );
+        void removeGroup( unsigned int group );
         
         Vector< Var > candidates;
         Vector< Var > answers;
         
         Solver& solver;
+        bool brave;
+
+        /*
+         * Candidates tested by core-based chunking are split in groups.
+         * The literal of a group is the negation of its candidate, or an
+         * auxiliary atom implying the disjunction of the negated candidates.
+         */
+        vector< vector< Var > > groups;
+        vector< Var > groupAux;
+        vector< Var > disabledAux;
+        vector< unsigned int > groupOfVariable;
+        unsigned int groupSize;
+
+        unsigned int numberOfCalls;
+        unsigned int numberOfCoherentCalls;
+        double solvingTime;
+        double maxCallTime;
 };
 
 #endif
@@ -20,13 +20,14 @@
 #include "input/Dimacs.h"
 #include "HCComponent.h"
 #include "weakconstraints/WeakInterface.h"
+#include "util/ThreadPool.h"
 #include <algorithm>
 #include <stdint.h>
 #include <vector>
 #include <time.h>
 using namespace std;
 
-vector< Clause* > Solver::learnedFromAllSolvers;
+SynchronizedQueue< Clause* > Solver::learnedFromAllSolvers;
 
 Solver::~Solver()
 {
@@ -76,6 +77,7 @@ Solver::~Solver()
         hcComponents.pop_back();
     }
     
+    delete checkerThreadPool;
     delete outputBuilder;
     delete satelite;
     delete restart;
@@ -219,6 +221,41 @@ Solver::addClauseFromModelAndRestart()
     return addClauseFromModel( clause );
 }
 
+bool
+Solver::addClauseFromProjectedModelAndRestart(
+    const vector< Var >& projection )
+{
+    assert( variables.numberOfAssignedLiterals() > 0 );
+
+    trace_msg( enumeration, 2, "Creating the clause representing the projected model." );
+    Clause* clause = newClause();
+
+    //Implied literals are added as well: decisions on hidden atoms do not identify the projected model.
+    for( unsigned int i = 0; i < projection.size(); i++ )
+    {
+        Var v = projection[ i ];
+        assert( !isUndefined( v ) );
+        if( getDecisionLevel( v ) == 0 )
+            continue;
+
+        Literal lit( v, isTrue( v ) ? NEGATIVE : POSITIVE );
+        trace_msg( enumeration, 2, "Adding literal " << lit << " in clause." );
+        clause->addLiteral( lit );
+    }
+
+    if( clause->size() == 0 )
+    {
+        releaseClause( clause );
+        return false;
+    }
+
+    unrollToZero();
+    simplifyOnRestart();
+    clearConflictStatus();
+
+    return addClauseFromModel( clause );
+}
+
 unsigned int 
 Solver::solveWithoutPropagators(
     vector< Literal >& assumptions )
@@ -260,7 +297,7 @@ Solver::solveWithoutPropagators(
             statistics( this, endSolving() );
             return INCOHERENT;
         }
-        if( ++numberOfChoices > maxNumberOfChoices  || numberOfRestarts > maxNumberOfRestarts || ( time( 0 ) - START_TIME ) > maxNumberOfSeconds )
+        if( ++numberOfChoices > maxNumberOfChoices  || numberOfRestarts > maxNumberOfRestarts || conflicts > maxNumberOfConflicts || ( time( 0 ) - START_TIME ) > maxNumberOfSeconds )
             return INTERRUPTED;        
         
         propagationLabel:;
@@ -327,7 +364,7 @@ Solver::solvePropagators(
             statistics( this, endSolving() );
             return INCOHERENT;
         }
-        if( ++numberOfChoices > maxNumberOfChoices || numberOfRestarts > maxNumberOfRestarts || ( time( 0 ) - START_TIME ) > maxNumberOfSeconds )
+        if( ++numberOfChoices > maxNumberOfChoices || numberOfRestarts > maxNumberOfRestarts || conflicts > maxNumberOfConflicts || ( time( 0 ) - START_TIME ) > maxNumberOfSeconds )
             return INTERRUPTED;        
         propagationLabel:;
         Var variableToPropagate;
@@ -372,6 +409,7 @@ Solver::solvePropagators(
             afterConflictPropagator = NULL;
         }
         
+        testHCComponentsConcurrently();
         while( !postPropagators.empty() )
         {
             PostPropagator* postPropagator = postPropagators.back();
@@ -391,6 +429,7 @@ Solver::solvePropagators(
             }
             else
             {
+                discardConcurrentChecks();
                 if( !wasp::Options::backwardPartialChecks )
                 {
                     if( learnedFromPropagators > ( learnedFromConflicts * 0.5 ) )
@@ -469,6 +508,46 @@ Solver::solvePropagators(
     return modelIsValidUnderAssumptions( assumptions ) ? COHERENT : INCOHERENT;
 }
 
+void
+Solver::testHCComponentsConcurrently()
+{
+    if( wasp::Options::modelCheckerThreads <= 1 || hcComponents.size() <= 1 )
+        return;
+
+    vector< HCComponent* > toCheck;
+    for( unsigned int i = 0; i < postPropagators.size(); i++ )
+    {
+        HCComponent* component = dynamic_cast< HCComponent* >( postPropagators[ i ] );
+        //The component waiting after a conflict might be in the stack twice.
+        if( component != NULL && component->hasToBeChecked() && find( toCheck.begin(), toCheck.end(), component ) == toCheck.end() )
+            toCheck.push_back( component );
+    }
+
+    if( toCheck.size() <= 1 )
+        return;
+
+    if( checkerThreadPool == NULL )
+        checkerThreadPool = new ThreadPool( min( wasp::Options::modelCheckerThreads, numberOfHCComponents() ) - 1 );
+
+    trace_msg( modelchecker, 1, "Checking " << toCheck.size() << " components concurrently" );
+    checkerThreadPool->run( toCheck.size(), [ &toCheck ]( unsigned int i ) { toCheck[ i ]->testModelConcurrently(); } );
+}
+
+void
+Solver::discardConcurrentChecks()
+{
+    //The assignment is going to change: results computed in advance are not valid anymore.
+    if( checkerThreadPool == NULL )
+        return;
+
+    for( unsigned int i = 0; i < postPropagators.size(); i++ )
+    {
+        HCComponent* component = dynamic_cast< HCComponent* >( postPropagators[ i ] );
+        if( component != NULL )
+            component->discardConcurrentCheck();
+    }
+}
+
 void
 Solver::shortPropagation(
     Var variable )
@@ -43,7 +43,9 @@ using namespace std;
 #include "WatchedList.h"
 #include "stl/BoundedQueue.h"
 #include "Component.h"
+#include "stl/SynchronizedQueue.h"
 class HCComponent;
+class ThreadPool;
 class WeakInterface;
 
 class DataStructures
@@ -79,6 +81,7 @@ struct OptimizationLiteralData
 
 class Solver
 {
+    friend class Snapshot;
     public:
         inline Solver();
         ~Solver();
@@ -103,6 +106,7 @@ class Solver
         inline void attachWatches();
         inline void clearComponents();
         inline void clearVariableOccurrences();
+        inline void onPreprocessingCompleted();
         
 //        inline void addVariable( const string& name );
         inline void addVariable();
@@ -119,6 +123,7 @@ class Solver
         inline bool addClauseFromModel( Clause* clause );
         void addLearnedClause( Clause* learnedClause, bool optimizeBinary );
         bool addClauseFromModelAndRestart();
+        bool addClauseFromProjectedModelAndRestart( const vector< Var >& projection );
         
         inline Literal getLiteral( int lit );
 //        inline Var getVariable( unsigned int var );
@@ -162,8 +167,9 @@ class Solver
         inline void foundIncoherence();
         inline bool hasUndefinedLiterals();
         inline void printAnswerSet();
+        inline const Vector< Var >& getShownVariables() { return outputBuilder->getShownVariables( numberOfVariables() ); }
         inline void printOptimizationValue( const Vector< uint64_t >& costs );
-        inline void printCautiousConsequences( const Vector< Var >& answers );        
+        inline void printConsequences( const Vector< Var >& answers );        
         inline void optimumFound();
         
         void unroll( unsigned int level );
@@ -249,6 +255,8 @@ class Solver
         inline Satelite* getSatelite() { return satelite; }
         
         inline void addAggregate( Aggregate* aggr ) { assert( aggr != NULL ); aggregates.push_back( aggr ); }
+        inline unsigned int numberOfAggregates() const { return aggregates.size(); }
+        inline const Aggregate& getAggregate( unsigned int i ) const { assert( i < aggregates.size() ); return *aggregates[ i ]; }
         inline bool hasPropagators() const { return ( !tight() || !aggregates.empty() ); }
         
         inline void turnOffSimplifications() { callSimplifications_ = false; }
@@ -267,6 +275,7 @@ class Solver
 //        inline void setNumberOfOptimizationLevels( unsigned int n ) { numberOfOptimizationLevels = n; }        
         inline void addPreferredChoicesFromOptimizationLiterals( unsigned int level );
         inline void removePrefChoices() { minisatHeuristic->removePrefChoices(); }
+        inline void saveSolutionPhases() { minisatHeuristic->saveSolutionPhases(); }
         
         inline bool isTrue( Var v ) const { return variables.isTrue( v ); }
         inline bool isFalse( Var v ) const { return variables.isFalse( v ); }        
@@ -293,6 +302,7 @@ class Solver
 
         inline TruthValue getTruthValue( Var v ) const { return variables.getTruthValue( v ); }
         inline TruthValue getCachedTruthValue( Var v ) const { return variables.getCachedTruthValue( v ); }
+        inline void setCachedTruthValue( Var v, TruthValue truth ) { variables.setCachedTruthValue( v, truth ); }
         
         inline void addWatchedClause( Literal lit, Clause* clause ) { getDataStructure( lit ).variableWatchedLists.add( clause ); }
         inline void findAndEraseWatchedClause( Literal lit, Clause* clause ) { getDataStructure( lit ).variableWatchedLists.findAndRemove( clause ); }
@@ -303,6 +313,7 @@ class Solver
         inline Clause* getOccurrence( Literal lit, unsigned index ) { return getDataStructure( lit ).variableAllOccurrences[ index ]; }
         inline unsigned int numberOfOccurrences( Literal lit ) const { return getDataStructure( lit ).variableAllOccurrences.size(); }
         inline unsigned int numberOfOccurrences( Var v ) const { Literal pos( v, POSITIVE ); return getDataStructure( pos ).variableAllOccurrences.size() + getDataStructure( pos.getOppositeLiteral() ).variableAllOccurrences.size(); }
+        inline const Vector< Literal >& getBinaryClauses( Literal lit ) const { return getDataStructure( lit ).variableBinaryClauses; }
         
         inline const Clause* getDefinition( Var v ) const { return variables.getDefinition( v ); }
 //        inline void setEliminated( Var v, Clause* definition ) { variablesData[ v ].definition = definition; }
@@ -320,6 +331,7 @@ class Solver
         inline HCComponent* getHCComponent( Var v ) { return variables.getHCComponent( v ); }
         
         inline void addPropagator( Literal lit, Propagator* p, int position ) { getDataStructure( lit ).variablePropagators.push_back( pair< Propagator*, int >( p, position ) ); }
+        inline void removePropagator( Literal lit, Propagator* p, int position ) { getDataStructure( lit ).variablePropagators.findAndRemove( pair< Propagator*, int >( p, position ) ); }
         inline void addPostPropagator( Literal lit, PostPropagator* p ) { getDataStructure( lit ).variablePostPropagators.push_back( p ); }
                 
         bool isFrozen( Var v ) const { return variables.isFrozen( v ); }
@@ -386,7 +398,7 @@ class Solver
         inline void setGenerator( bool gen ) { generator = gen; statistics( this, setGenerator( gen ) ); }        
         inline void setAfterConflictPropagator( PostPropagator* p ) { assert( afterConflictPropagator == NULL ); afterConflictPropagator = p; }
         
-        static void addClauseInLearnedFromAllSolvers( Clause* c ) { learnedFromAllSolvers.push_back( c ); }
+        static void addClauseInLearnedFromAllSolvers( Clause* c ) { learnedFromAllSolvers.push( c ); }
         
         inline void disableStatistics() { statistics( this, disable() ); }
         inline void enableStatistics() { statistics( this, enable() ); }
@@ -427,6 +439,9 @@ class Solver
         inline void setMaxNumberOfChoices( unsigned int max ) { maxNumberOfChoices = max; }
         inline void setMaxNumberOfRestarts( unsigned int max ) { maxNumberOfRestarts = max; }
         inline void setMaxNumberOfSeconds( unsigned int max ) { maxNumberOfSeconds = max; }
+        inline void setMaxNumberOfConflicts( uint64_t max ) { maxNumberOfConflicts = max; }
+        inline uint64_t getNumberOfConflicts() const { return conflicts; }
+        inline void setUnsatCore( Clause* core ) { delete unsatCore; unsatCore = core; }
         inline uint64_t getPrecomputedCost( unsigned int level ) const { assert( level < precomputedCosts.size() ); return precomputedCosts[ level ]; }
 //        inline uint64_t getPrecomputedCost() const { return precomputedCost; }                
         
@@ -445,7 +460,10 @@ class Solver
         PostPropagator* afterConflictPropagator;
         bool exchangeClauses_;
         bool generator;
-        static vector< Clause* > learnedFromAllSolvers;
+        static SynchronizedQueue< Clause* > learnedFromAllSolvers;
+        ThreadPool* checkerThreadPool;
+        void testHCComponentsConcurrently();
+        void discardConcurrentChecks();
 
         unsigned int solveWithoutPropagators( vector< Literal >& assumptions );
         unsigned int solvePropagators( vector< Literal >& assumptions );
@@ -619,6 +637,7 @@ class Solver
         unsigned int maxNumberOfRestarts;
         unsigned int numberOfRestarts;
         unsigned int maxNumberOfSeconds;
+        uint64_t maxNumberOfConflicts;
         
         bool incremental_;
         
@@ -642,6 +661,7 @@ Solver::Solver()
     afterConflictPropagator( NULL ),
     exchangeClauses_( false ),
     generator( true ),
+    checkerThreadPool( NULL ),
     currentDecisionLevel( 0 ),
     conflictLiteral( Literal::null ),
     conflictClause( NULL ),
@@ -671,6 +691,7 @@ Solver::Solver()
     maxNumberOfRestarts( UINT_MAX ),
     numberOfRestarts( 0 ),
     maxNumberOfSeconds( UINT_MAX ),
+    maxNumberOfConflicts( UINT64_MAX ),
     incremental_( false )
 {
     dependencyGraph = new DependencyGraph( *this );
@@ -743,7 +764,9 @@ Solver::setOutputBuilder(
 void
 Solver::addVariableInternal()
 {
-    VariableNames::addVariable();
+    //Checkers may run on several threads: only the generator owns the names.
+    if( generator )
+        VariableNames::addVariable();
     variables.push_back();    
     minisatHeuristic->onNewVariable( variables.numberOfVariables() );
     learning.onNewVariable();
@@ -1117,10 +1140,9 @@ Solver::doRestart()
 
     if( generator && exchangeClauses_ )
     {
-        while( !learnedFromAllSolvers.empty() )
+        Clause* c;
+        while( learnedFromAllSolvers.tryPop( c ) )
         {
-            Clause* c = learnedFromAllSolvers.back();
-            learnedFromAllSolvers.pop_back();            
             if( !cleanAndAddLearnedClause( c ) )
                 return false;
         }
@@ -1213,9 +1235,10 @@ Solver::printOptimizationValue(
 }
 
 void
-Solver::printCautiousConsequences(
+Solver::printConsequences(
     const Vector< Var >& answers )
 {
+    outputBuilder->getShownVariables( numberOfVariables() );
     outputBuilder->startModel();
     for( unsigned int i = 0; i < answers.size(); ++i )
         outputBuilder->printVariable( answers[ i ], true );
@@ -1570,16 +1593,21 @@ Solver::preprocessing()
     clearVariableOccurrences();
     attachWatches();
     clearComponents();
-    
+    onPreprocessingCompleted();
+    statistics( this, afterPreprocessing( numberOfAssignedLiterals(), numberOfClauses() ) );
+
+    return true;
+}
+
+void
+Solver::onPreprocessingCompleted()
+{
     assignedVariablesAtLevelZero = numberOfAssignedLiterals();
     
     deletionCounters.maxLearned = numberOfClauses() * deletionCounters.learnedSizeFactor;
     deletionCounters.learnedSizeAdjustConfl = deletionCounters.learnedSizeAdjustStartConfl;
     deletionCounters.learnedSizeAdjustCnt = ( unsigned int ) deletionCounters.learnedSizeAdjustConfl;
     callSimplifications_ = false;
-    statistics( this, afterPreprocessing( numberOfAssignedLiterals(), numberOfClauses() ) );
-
-    return true;
 }
 
 void
@@ -1969,6 +1997,12 @@ Solver::attachAggregate(
     Literal aggregateLiteral = aggregate[ 1 ].getOppositeLiteral();
     addPropagator( aggregateLiteral, &aggregate, -1 );
     addPropagator( aggregateLiteral.getOppositeLiteral(), &aggregate, 1 );    
+    if( wasp::Options::aggregateWatchSize > 0 && aggregate.size() >= wasp::Options::aggregateWatchSize )
+    {
+        aggregate.enableWatchedSubset( *this );
+        return;
+    }
+    
     for( unsigned int j = 2; j <= aggregate.size(); j++ )
     {
         Literal lit = aggregate[ j ];
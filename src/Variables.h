@@ -104,6 +104,7 @@ class Variables
         
         inline TruthValue getTruthValue( Var v ) const { return assigns[ v ] & UNROLL_MASK; }
         inline TruthValue getCachedTruthValue( Var v ) const { return assigns[ v ] >> UNROLL_MASK; }
+        inline void setCachedTruthValue( Var v, TruthValue truth ) { assert( isUndefined( v ) ); assigns[ v ] = truth << UNROLL_MASK; }
         
         inline bool setTrue( Literal lit );        
         
@@ -254,10 +255,11 @@ void
 Variables::printAnswerSet(
     OutputBuilder* outputBuilder ) const
 {
+    const Vector< Var >& shownVariables = outputBuilder->getShownVariables( numberOfVariables() );
     outputBuilder->startModel();
-    for( unsigned int i = 0; i < assignedVariablesSize; ++i )
+    for( unsigned int i = 0; i < shownVariables.size(); ++i )
     {
-        Var v = assignedVariables[ i ];        
+        Var v = shownVariables[ i ];
         outputBuilder->printVariable( v, isTrue( v ) );
     }
     outputBuilder->endModel();
@@ -21,6 +21,8 @@
 #include "Restart.h"
 
 #include "input/GringoNumericFormat.h"
+#include "input/Snapshot.h"
+#include "util/Istream.h"
 
 #include "outputBuilders/WaspOutputBuilder.h"
 #include "outputBuilders/SilentOutputBuilder.h"
@@ -28,25 +30,31 @@
 #include "outputBuilders/CompetitionOutputBuilder.h"
 #include "outputBuilders/DimacsOutputBuilder.h"
 
+#include <unistd.h>
+#include <unordered_map>
+
 #include "MinisatHeuristic.h"
 #include "outputBuilders/MultiOutputBuilder.h"
+#include "outputBuilders/BinaryOutputBuilder.h"
 #include "QueryInterface.h"
 
 void
 WaspFacade::readInput()
 {
-    char tmp;
-
-    *inputStream >> tmp;
-
-	if( !inputStream->good() && !inputStream->eof() )
-	{
-		ErrorMessage::errorDuringParsing( "Unexpected symbol." );
-	}
+    if( !snapshotToLoad.empty() )
+    {
+        readSnapshot();
+        return;
+    }
 
-	inputStream->putback( tmp );
+    //The standard input is read through its descriptor: redirected files are memory mapped.
+    Istream* in;
+    if( inputStream == &cin )
+        in = new Istream( STDIN_FILENO );
+    else
+        in = new Istream( *inputStream );
 
-    switch ( tmp )
+    switch ( in->peek() )
     {
         case COMMENT_DIMACS:
         case FORMULA_INFO_DIMACS:
@@ -54,21 +62,24 @@ WaspFacade::readInput()
             DimacsOutputBuilder* d = new DimacsOutputBuilder();
             solver.setOutputBuilder( d );
             Dimacs dimacs( solver );
-            dimacs.parse();
+            dimacs.parse( *in );
+            inputFormat = SNAPSHOT_DIMACS;
             if( dimacs.isMaxsat() )
+            {
                 d->setMaxsat();
+                inputFormat = SNAPSHOT_MAXSAT;
+            }
             greetings();
             break;
         }
 
         default:
         {
-            Istream in ( *inputStream );
             GringoNumericFormat gringo( solver, debugInterface );
-            gringo.parse( in );
+            gringo.parse( *in );
 
             if( debugInterface != NULL ) {
-                debugInterface->readDebugMapping( in );
+                debugInterface->readDebugMapping( *in );
                 solver.disableVariableElimination();
             }
 
@@ -78,6 +89,33 @@ WaspFacade::readInput()
             break;
         }
     }
+    delete in;
+}
+
+void
+WaspFacade::readSnapshot()
+{
+    if( debugInterface != NULL )
+        ErrorMessage::errorGeneric( "Snapshots cannot be used in debug mode." );
+
+    Snapshot snapshot( solver );
+    inputFormat = snapshot.load( snapshotToLoad );
+    if( inputFormat != SNAPSHOT_GRINGO )
+    {
+        DimacsOutputBuilder* d = new DimacsOutputBuilder();
+        if( inputFormat == SNAPSHOT_MAXSAT )
+            d->setMaxsat();
+        solver.setOutputBuilder( d );
+    }
+    greetings();
+}
+
+void
+WaspFacade::saveSnapshot()
+{
+    Snapshot snapshot( solver );
+    if( !snapshot.save( snapshotToSave, inputFormat ) )
+        cerr << "Warning: programs with head-cycle components cannot be stored in a snapshot." << endl;
 }
 
 void
@@ -89,7 +127,15 @@ WaspFacade::solve()
         return;
     }   
     
-    if( solver.preprocessing() )
+    if( projection )
+        computeProjection();
+
+    //A snapshot stores the program as it is after preprocessing.
+    bool coherent = snapshotToLoad.empty() ? solver.preprocessing() : !solver.conflictDetected();
+    if( !snapshotToSave.empty() )
+        saveSnapshot();
+
+    if( coherent )
     {
         if( printDimacs )
         {
@@ -106,27 +152,19 @@ WaspFacade::solve()
         if( queryAlgorithm != NO_QUERY )
         {
             QueryInterface queryInterface( solver );
-            queryInterface.computeCautiousConsequences( queryAlgorithm );
+            if( queryAlgorithm == BRAVE_CONSEQUENCES )
+                queryInterface.computeBraveConsequences();
+            else
+                queryInterface.computeCautiousConsequences( queryAlgorithm );
             return;
         }
         
         if( !solver.isOptimizationProblem() )
-        {            
-            while( solver.solve() == COHERENT )
-            {
-                solver.printAnswerSet();
-                trace_msg( enumeration, 1, "Model number: " << numberOfModels + 1 );
-                if( ++numberOfModels >= maxModels )
-                {
-                    trace_msg( enumeration, 1, "Enumerated " << maxModels << "." );
-                    break;
-                }
-                else if( !solver.addClauseFromModelAndRestart() )
-                {
-                    trace_msg( enumeration, 1, "All models have been found." );
-                    break;
-                }
-            }
+        {
+            if( enumerationStrategy == ENUMERATION_BACKTRACKING && maxModels > 1 )
+                enumerationBacktracking();
+            else
+                enumerationBlockingClauses();
         }
         else
         {
@@ -159,6 +197,181 @@ WaspFacade::solve()
 //    solver.printLearnedClauses();
 }
 
+void
+WaspFacade::enumerationBlockingClauses()
+{
+    while( solver.solve() == COHERENT )
+    {
+        solver.printAnswerSet();
+        trace_msg( enumeration, 1, "Model number: " << numberOfModels + 1 );
+        if( ++numberOfModels >= maxModels )
+        {
+            trace_msg( enumeration, 1, "Enumerated " << maxModels << "." );
+            break;
+        }
+        else if( projection ? !solver.addClauseFromProjectedModelAndRestart( projectedVariables ) : !solver.addClauseFromModelAndRestart() )
+        {
+            trace_msg( enumeration, 1, "All models have been found." );
+            break;
+        }
+    }
+}
+
+/*
+ * The decisions of the current branch are passed to the solver as assumptions.
+ * Once a model is found, its decisions extend the branch and the last decision
+ * whose opposite has not been explored yet is flipped. A branch without models
+ * is handled in the same way. No clause is added, hence the memory used does
+ * not depend on the number of models.
+ * With projection, the branch is extended by all projected literals instead:
+ * the branch then fixes the projected model, and flipping any of them leads
+ * to different projected models only.
+ */
+void
+WaspFacade::enumerationBacktracking()
+{
+    vector< Literal > branch;
+    vector< bool > flipped;
+    vector< Literal > decisions;
+    vector< bool > projected;
+    if( projection )
+    {
+        projected.resize( solver.numberOfVariables() + 1, false );
+        for( unsigned int i = 0; i < projectedVariables.size(); i++ )
+            projected[ projectedVariables[ i ] ] = true;
+    }
+
+    while( true )
+    {
+        if( solver.solve( branch ) == COHERENT )
+        {
+            solver.printAnswerSet();
+            trace_msg( enumeration, 1, "Model number: " << numberOfModels + 1 );
+            if( ++numberOfModels >= maxModels )
+            {
+                trace_msg( enumeration, 1, "Enumerated " << maxModels << "." );
+                break;
+            }
+
+            if( projection )
+            {
+                //Projected atoms assigned after the branch are added in the order of the trail, so that they fix the projected model.
+                unsigned int branchSize = branch.size();
+                for( unsigned int i = 0; i < solver.numberOfAssignedLiterals(); i++ )
+                {
+                    Var v = solver.getAssignedVariable( i );
+                    if( !projected[ v ] || solver.getDecisionLevel( v ) <= branchSize )
+                        continue;
+                    Literal lit( v, solver.isTrue( v ) ? POSITIVE : NEGATIVE );
+                    trace_msg( enumeration, 2, "Adding projected literal " << lit << " to the branch." );
+                    branch.push_back( lit );
+                    flipped.push_back( false );
+                }
+                //Added literals do not match the levels of the solver, which are restored to the previous branch.
+                if( solver.getCurrentDecisionLevel() > branchSize )
+                    solver.unroll( branchSize );
+            }
+            else
+            {
+                //Levels up to branch.size() belong to assumptions, each of the others contains one decision.
+                decisions.assign( solver.getCurrentDecisionLevel() - branch.size(), Literal::null );
+                for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+                {
+                    unsigned int level = solver.getDecisionLevel( v );
+                    if( level > branch.size() && !solver.hasImplicant( v ) )
+                        decisions[ level - branch.size() - 1 ] = Literal( v, solver.isTrue( v ) ? POSITIVE : NEGATIVE );
+                }
+
+                for( unsigned int i = 0; i < decisions.size(); i++ )
+                {
+                    if( decisions[ i ] == Literal::null )
+                        continue;
+                    trace_msg( enumeration, 2, "Adding decision " << decisions[ i ] << " to the branch." );
+                    branch.push_back( decisions[ i ] );
+                    flipped.push_back( false );
+                }
+            }
+        }
+
+        if( !flipLastDecision( branch, flipped ) )
+        {
+            trace_msg( enumeration, 1, "All models have been found." );
+            break;
+        }
+    }
+}
+
+bool
+WaspFacade::flipLastDecision(
+    vector< Literal >& branch,
+    vector< bool >& flipped )
+{
+    while( !branch.empty() && flipped.back() )
+    {
+        branch.pop_back();
+        flipped.pop_back();
+    }
+
+    if( branch.empty() )
+        return false;
+
+    branch.back() = branch.back().getOppositeLiteral();
+    flipped.back() = true;
+    trace_msg( enumeration, 2, "Flipping " << branch.back().getOppositeLiteral() << "." );
+
+    //Assumptions before the flipped one are still assigned, at their levels.
+    if( solver.getCurrentDecisionLevel() >= branch.size() )
+        solver.unroll( branch.size() - 1 );
+    solver.clearConflictStatus();
+    return true;
+}
+
+void
+WaspFacade::computeProjection()
+{
+    if( projectionFile.empty() )
+    {
+        const Vector< Var >& shown = solver.getShownVariables();
+        for( unsigned int i = 0; i < shown.size(); i++ )
+            projectedVariables.push_back( shown[ i ] );
+    }
+    else
+    {
+        ifstream in( projectionFile.c_str() );
+        if( !in.good() )
+            ErrorMessage::errorGeneric( "Could not read the projection file " + projectionFile + "." );
+
+        unordered_map< string, Var > atoms;
+        for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+            if( !VariableNames::isHidden( v ) )
+                atoms[ VariableNames::getName( v ) ] = v;
+
+        vector< bool > added( solver.numberOfVariables() + 1, false );
+        string name;
+        while( getline( in, name ) )
+        {
+            while( !name.empty() && isspace( name[ name.size() - 1 ] ) )
+                name.erase( name.size() - 1 );
+            //Atoms removed by the grounder are false in all models.
+            unordered_map< string, Var >::const_iterator it = atoms.find( name );
+            if( it == atoms.end() || added[ it->second ] )
+                continue;
+            added[ it->second ] = true;
+            projectedVariables.push_back( it->second );
+        }
+    }
+
+    //Projected atoms must not be eliminated by the preprocessing.
+    for( unsigned int i = 0; i < projectedVariables.size(); i++ )
+    {
+        Var v = projectedVariables[ i ];
+        if( solver.hasBeenEliminated( v ) )
+            ErrorMessage::errorGeneric( "Projected atoms have been eliminated in the snapshot: save it with --project." );
+        solver.setFrozen( v );
+    }
+    trace_msg( enumeration, 1, "Projecting on " << projectedVariables.size() << " atoms." );
+}
+
 void
 WaspFacade::setDeletionPolicy(
     DELETION_POLICY deletionPolicy,
@@ -241,6 +454,10 @@ WaspFacade::setOutputPolicy(
         case MULTI:
             solver.setOutputBuilder( new MultiOutputBuilder() );
             break;
+
+        case BINARY_OUTPUT:
+            solver.setOutputBuilder( new BinaryOutputBuilder() );
+            break;
             
         case WASP_OUTPUT:
         default:
@@ -27,6 +27,7 @@
 #include <cassert>
 #include <sstream>
 #include <unordered_set>
+#include <unistd.h>
 using namespace std;
 
 Dimacs::Dimacs(
@@ -37,7 +38,7 @@ Dimacs::Dimacs(
 void
 Dimacs::parse()
 {
-    Istream input( cin );
+    Istream input( STDIN_FILENO );
     this->parse( input );
 }
 
@@ -12,12 +12,13 @@
 #include <unordered_set>
 #include <bitset>
 #include <stdint.h>
+#include <unistd.h>
 using namespace std;
 
 void
 GringoNumericFormat::parse()
 {
-    Istream input( cin );
+    Istream input( STDIN_FILENO );
     this->parse( input );
 }
 
@@ -92,6 +93,8 @@ GringoNumericFormat::parse(
     readAtomsTable( input );
     readTrueAtoms( input );
     readFalseAtoms( input );
+    if( !symbolTable.empty() )
+        VariableNames::setUnparsedNames( symbolTable, solver.numberOfVariables() );
     readErrorNumber( input );
     propagate();
 
@@ -1060,6 +1063,13 @@ void
 GringoNumericFormat::readAtomsTable(
     Istream& input )
 {
+    //Names are not needed while parsing unless they are inspected by queries or by the debugger.
+    if( wasp::Options::lazySymbolTable && wasp::Options::queryAlgorithm == NO_QUERY && debugInterface == NULL )
+    {
+        input.copyLinesUntil( "0", symbolTable );
+        return;
+    }
+
     unsigned int nextAtom;
     input.read( nextAtom );
 
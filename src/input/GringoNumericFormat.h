@@ -21,7 +21,7 @@
 
 #include "../Solver.h"
 #include "../debug/DebugInterface.h"
-#include "../stl/Trie.h"
+#include "../stl/SequenceDictionary.h"
 #include "../util/Istream.h"
 #include <unordered_set>
 
@@ -439,7 +439,8 @@ private:
     Solver& solver;
     DebugInterface* debugInterface;
     
-    Trie bodiesDictionary;
+    SequenceDictionary bodiesDictionary;
+    string symbolTable;
     
 //    vector< unsigned int > inputVarId;
 //    vector< unsigned int > auxVarId;
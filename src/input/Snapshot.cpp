@@ -0,0 +1,613 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+
+#include "Snapshot.h"
+
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define SNAPSHOT_MMAP
+#endif
+
+#include "../Solver.h"
+#include "../HCComponent.h"
+#include "../util/ErrorMessage.h"
+#include "../util/VariableNames.h"
+
+#define SNAPSHOT_MAGIC 0x50534157
+#define SNAPSHOT_VERSION 3
+#define SNAPSHOT_BUFFER_SIZE ( 1 << 20 )
+
+Snapshot::~Snapshot()
+{
+    #ifdef SNAPSHOT_MMAP
+    if( file != NULL )
+        munmap( file, fileSize );
+    #endif
+    delete [] buffer;
+}
+
+bool
+Snapshot::save(
+    const string& filename,
+    unsigned int format )
+{
+    bool conflict = solver.conflictDetected();
+    if( !conflict && !canBeSaved() )
+        return false;
+
+    out = fopen( filename.c_str(), "wb" );
+    if( out == NULL )
+        ErrorMessage::errorGeneric( "Cannot create the snapshot " + filename + "." );
+    setvbuf( out, NULL, _IOFBF, SNAPSHOT_BUFFER_SIZE );
+
+    write( SNAPSHOT_MAGIC );
+    write( SNAPSHOT_VERSION );
+    write( format );
+    write( conflict );
+    if( !conflict )
+    {
+        saveVariables();
+        saveClauses();
+        saveAggregates();
+        saveComponents();
+        saveOptimizationLiterals();
+    }
+    write( SNAPSHOT_MAGIC );
+
+    bool failed = ferror( out );
+    if( fclose( out ) != 0 || failed )
+        ErrorMessage::errorGeneric( "Cannot write the snapshot " + filename + "." );
+    out = NULL;
+    return true;
+}
+
+bool
+Snapshot::canBeSaved()
+{
+    //Head-cycle components own a checker solver, which is not stored.
+    if( !solver.hcComponents.empty() )
+        return false;
+
+    for( unsigned int i = 0; i < solver.aggregates.size(); i++ )
+        propagatorPositions[ solver.aggregates[ i ] ] = i;
+    for( unsigned int i = 0; i < solver.cyclicComponents.size(); i++ )
+        postPropagatorPositions[ solver.cyclicComponents[ i ] ] = i;
+
+    for( unsigned int i = 2; i <= solver.numberOfVariables() * 2 + 1; i++ )
+    {
+        const DataStructures& data = *solver.variableDataStructures[ i ];
+        for( unsigned int j = 0; j < data.variablePropagators.size(); j++ )
+            if( propagatorPositions.find( data.variablePropagators[ j ].first ) == propagatorPositions.end() )
+                return false;
+        for( unsigned int j = 0; j < data.variablePostPropagators.size(); j++ )
+            if( postPropagatorPositions.find( data.variablePostPropagators[ j ] ) == postPropagatorPositions.end() )
+                return false;
+    }
+
+    for( unsigned int i = 0; i < solver.postPropagators.size(); i++ )
+        if( postPropagatorPositions.find( solver.postPropagators[ i ] ) == postPropagatorPositions.end() )
+            return false;
+
+    for( unsigned int i = 0; i < solver.propagatorsForUnroll.size(); i++ )
+        if( propagatorPositions.find( solver.propagatorsForUnroll[ i ] ) == propagatorPositions.end() )
+            return false;
+
+    return solver.fromLevelToPropagators.size() == 1;
+}
+
+void
+Snapshot::saveVariables()
+{
+    unsigned int numberOfVariables = solver.numberOfVariables();
+    write( numberOfVariables );
+
+    for( Var v = 1; v <= numberOfVariables; v++ )
+    {
+        write( string( VariableNames::isHidden( v ) ? "" : VariableNames::getName( v ) ) );
+        write( solver.isFrozen( v ) );
+    }
+
+    write( solver.numberOfAssignedLiterals() );
+    for( unsigned int i = 0; i < solver.numberOfAssignedLiterals(); i++ )
+    {
+        Var v = solver.getAssignedVariable( i );
+        write( v );
+        if( !solver.hasBeenEliminated( v ) )
+        {
+            write( solver.isTrue( v ) ? 0 : 1 );
+            continue;
+        }
+
+        unsigned int sign = solver.getSignOfEliminatedVariable( v );
+        write( sign + 2 );
+        if( sign != ELIMINATED_BY_DISTRIBUTION )
+            write( *solver.getDefinition( v ) );
+    }
+
+    for( unsigned int i = 2; i <= numberOfVariables * 2 + 1; i++ )
+        writeLiterals( solver.variableDataStructures[ i ]->variableBinaryClauses );
+}
+
+void
+Snapshot::saveClauses()
+{
+    write( solver.numberOfClauses() );
+    for( unsigned int i = 0; i < solver.numberOfClauses(); i++ )
+        write( *solver.clauseAt( i ) );
+}
+
+void
+Snapshot::saveAggregates()
+{
+    write( solver.aggregates.size() );
+    for( unsigned int i = 0; i < solver.aggregates.size(); i++ )
+    {
+        const Aggregate& aggregate = *solver.aggregates[ i ];
+        writeLiterals( aggregate.literals );
+        for( unsigned int j = 0; j < aggregate.weights.size(); j++ )
+            write64( aggregate.weights[ j ] );
+        for( unsigned int j = 0; j < aggregate.watched.size(); j++ )
+            write( aggregate.watched[ j ] );
+        write( aggregate.active );
+        write64( aggregate.counterW1 );
+        write64( aggregate.counterW2 );
+        write64( aggregate.bound_ );
+        write( aggregate.umax );
+        writeVariables( aggregate.trail );
+        write( aggregate.literalOfUnroll );
+        writeVariables( aggregate.subset );
+        write64( aggregate.outside[ 0 ] );
+        write64( aggregate.outside[ 1 ] );
+        write( aggregate.cursor[ 0 ] );
+        write( aggregate.cursor[ 1 ] );
+        writeVariables( aggregate.trailLevels );
+    }
+
+    for( unsigned int i = 2; i <= solver.numberOfVariables() * 2 + 1; i++ )
+    {
+        const Vector< pair< Propagator*, int > >& propagators = solver.variableDataStructures[ i ]->variablePropagators;
+        write( propagators.size() );
+        for( unsigned int j = 0; j < propagators.size(); j++ )
+        {
+            write( positionOf( propagatorPositions, propagators[ j ].first ) );
+            write( propagators[ j ].second );
+        }
+    }
+
+    write( solver.propagatorsForUnroll.size() );
+    for( unsigned int i = 0; i < solver.propagatorsForUnroll.size(); i++ )
+        write( positionOf( propagatorPositions, solver.propagatorsForUnroll[ i ] ) );
+}
+
+void
+Snapshot::saveComponents()
+{
+    write( solver.gusDataVector.size() );
+    for( unsigned int i = 0; i < solver.gusDataVector.size(); i++ )
+    {
+        const GUSData* gusData = solver.gusDataVector[ i ];
+        write( gusData != NULL );
+        if( gusData == NULL )
+            continue;
+
+        assert( gusData->definingRulesForNonHCFAtom.empty() );
+        writeLiterals( gusData->externalLiterals );
+        writeLiterals( gusData->internalLiterals );
+        for( unsigned int sign = 0; sign < 2; sign++ )
+        {
+            writeVariables( gusData->supportedByThisExternalRule[ sign ] );
+            writeVariables( gusData->supportedByThisInternalRule[ sign ] );
+            writeVariables( gusData->auxVariablesSupportedByThis[ sign ] );
+            writeVariables( gusData->possiblySupportedByThis[ sign ] );
+        }
+        writeLiterals( gusData->literals );
+        write( gusData->numberOfSupporting );
+        write( gusData->sourcePointer );
+        write( gusData->aux );
+        write( gusData->founded );
+        write( gusData->inQueue );
+        write( gusData->inUnfoundedSet );
+        write( gusData->propagated );
+    }
+
+    write( solver.cyclicComponents.size() );
+    for( unsigned int i = 0; i < solver.cyclicComponents.size(); i++ )
+    {
+        const Component& component = *solver.cyclicComponents[ i ];
+        assert( component.unfoundedSet.empty() && component.clauseToPropagate == NULL );
+        writeVariables( component.variablesInComponent );
+        writeVariables( component.variablesWithoutSourcePointer );
+        write( component.first );
+    }
+
+    for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+    {
+        Component* component = solver.getComponent( v );
+        write( component == NULL ? 0 : positionOf< PostPropagator >( postPropagatorPositions, component ) + 1 );
+    }
+
+    for( unsigned int i = 2; i <= solver.numberOfVariables() * 2 + 1; i++ )
+    {
+        const Vector< PostPropagator* >& postPropagators = solver.variableDataStructures[ i ]->variablePostPropagators;
+        write( postPropagators.size() );
+        for( unsigned int j = 0; j < postPropagators.size(); j++ )
+            write( positionOf( postPropagatorPositions, postPropagators[ j ] ) );
+    }
+
+    write( solver.postPropagators.size() );
+    for( unsigned int i = 0; i < solver.postPropagators.size(); i++ )
+        write( positionOf( postPropagatorPositions, solver.postPropagators[ i ] ) );
+}
+
+void
+Snapshot::saveOptimizationLiterals()
+{
+    write( solver.numberOfLevels() );
+    for( unsigned int level = 0; level < solver.numberOfLevels(); level++ )
+    {
+        write( solver.isWeighted( level ) );
+        write64( solver.getPrecomputedCost( level ) );
+        write( solver.numberOfOptimizationLiterals( level ) );
+        for( unsigned int i = 0; i < solver.numberOfOptimizationLiterals( level ); i++ )
+        {
+            OptimizationLiteralData& data = solver.getOptimizationLiteral( level, i );
+            write( data.lit );
+            write64( data.weight );
+            write( data.removed | ( data.aux << 1 ) );
+        }
+    }
+    write64( solver.precomputedCost );
+}
+
+void
+Snapshot::write(
+    const string& s )
+{
+    write( s.size() );
+    fwrite( s.data(), 1, s.size(), out );
+    //Keep the following words aligned.
+    uint32_t padding = 0;
+    fwrite( &padding, 1, ( 4 - s.size() % 4 ) % 4, out );
+}
+
+void
+Snapshot::write(
+    const Clause& clause )
+{
+    write( clause.size() );
+    for( unsigned int i = 0; i < clause.size(); i++ )
+        write( clause[ i ] );
+}
+
+unsigned int
+Snapshot::load(
+    const string& filename )
+{
+    open( filename );
+    if( read() != SNAPSHOT_MAGIC )
+        corrupted();
+    if( read() != SNAPSHOT_VERSION )
+        ErrorMessage::errorGeneric( "The snapshot " + filename + " has been created by a different version." );
+
+    unsigned int format = read();
+    if( read() )
+    {
+        solver.conflictLiteral = Literal::conflict;
+        return format;
+    }
+
+    loadVariables();
+    loadClauses();
+    loadAggregates();
+    loadComponents();
+    loadOptimizationLiterals();
+    if( read() != SNAPSHOT_MAGIC || current != end )
+        corrupted();
+
+    //The dependency graph has been consumed when the snapshot was created.
+    delete solver.dependencyGraph;
+    solver.dependencyGraph = NULL;
+    solver.minisatHeuristic->simplifyVariablesAtLevelZero();
+    solver.onPreprocessingCompleted();
+    return format;
+}
+
+void
+Snapshot::open(
+    const string& filename )
+{
+    int fileDescriptor = ::open( filename.c_str(), O_RDONLY );
+    if( fileDescriptor < 0 )
+        ErrorMessage::errorGeneric( "Cannot open the snapshot " + filename + "." );
+
+    #ifdef SNAPSHOT_MMAP
+    struct stat info;
+    if( fstat( fileDescriptor, &info ) == 0 && S_ISREG( info.st_mode ) && info.st_size > 0 )
+    {
+        void* mapped = mmap( NULL, info.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+        if( mapped != MAP_FAILED )
+        {
+            madvise( mapped, info.st_size, MADV_SEQUENTIAL );
+            file = mapped;
+            fileSize = info.st_size;
+            close( fileDescriptor );
+            current = static_cast< const uint32_t* >( file );
+            end = current + fileSize / sizeof( uint32_t );
+            return;
+        }
+    }
+    #endif
+    close( fileDescriptor );
+
+    ifstream in( filename.c_str(), ios::binary | ios::ate );
+    fileSize = in.tellg();
+    buffer = new uint32_t[ fileSize / sizeof( uint32_t ) + 1 ];
+    in.seekg( 0 );
+    if( !in.read( reinterpret_cast< char* >( buffer ), fileSize ) )
+        corrupted();
+    current = buffer;
+    end = buffer + fileSize / sizeof( uint32_t );
+}
+
+void
+Snapshot::loadVariables()
+{
+    unsigned int numberOfVariables = read();
+    string name;
+    for( Var v = 1; v <= numberOfVariables; v++ )
+    {
+        solver.addVariable();
+        read( name );
+        if( !name.empty() )
+            VariableNames::setName( v, name );
+        if( read() )
+            solver.setFrozen( v );
+    }
+
+    unsigned int numberOfAssignedLiterals = read();
+    for( unsigned int i = 0; i < numberOfAssignedLiterals; i++ )
+    {
+        Var v = read();
+        unsigned int kind = read();
+        if( v == 0 || v > numberOfVariables || kind > ELIMINATED_BY_DISTRIBUTION + 2 || !solver.isUndefined( v ) )
+            corrupted();
+
+        if( kind < 2 )
+            solver.variables.assign( 0, Literal( v, kind ) );
+        else
+            solver.onEliminatingVariable( v, kind - 2, kind - 2 == ELIMINATED_BY_DISTRIBUTION ? NULL : readClause() );
+    }
+    //Consequences at level 0 have been propagated before saving.
+    solver.variables.resetLiteralsToPropagate();
+
+    for( unsigned int i = 2; i <= numberOfVariables * 2 + 1; i++ )
+        readLiterals( solver.variableDataStructures[ i ]->variableBinaryClauses );
+}
+
+void
+Snapshot::loadClauses()
+{
+    unsigned int numberOfClauses = read();
+    solver.clauses.reserve( numberOfClauses );
+    for( unsigned int i = 0; i < numberOfClauses; i++ )
+    {
+        Clause* clause = readClause();
+        if( clause->size() < 3 )
+            corrupted();
+        clause->setPositionInSolver( solver.clauses.size() );
+        solver.clauses.push_back( clause );
+        solver.literalsInClauses += clause->size();
+        solver.attachClause( *clause );
+    }
+}
+
+void
+Snapshot::loadAggregates()
+{
+    unsigned int numberOfAggregates = read();
+    for( unsigned int i = 0; i < numberOfAggregates; i++ )
+    {
+        Aggregate* aggregate = new Aggregate();
+        aggregate->literals.clear();
+        aggregate->weights.clear();
+        aggregate->watched.clear();
+
+        readLiterals( aggregate->literals );
+        for( unsigned int j = 0; j < aggregate->literals.size(); j++ )
+            aggregate->weights.push_back( read64() );
+        for( unsigned int j = 0; j < aggregate->literals.size(); j++ )
+            aggregate->watched.push_back( read() );
+        aggregate->active = read();
+        aggregate->counterW1 = read64();
+        aggregate->counterW2 = read64();
+        aggregate->bound_ = read64();
+        aggregate->umax = read();
+        readVariables( aggregate->trail );
+        aggregate->literalOfUnroll = readLiteral();
+        readVariables( aggregate->subset );
+        aggregate->outside[ 0 ] = read64();
+        aggregate->outside[ 1 ] = read64();
+        aggregate->cursor[ 0 ] = read();
+        aggregate->cursor[ 1 ] = read();
+        readVariables( aggregate->trailLevels );
+        solver.addAggregate( aggregate );
+    }
+
+    for( unsigned int i = 2; i <= solver.numberOfVariables() * 2 + 1; i++ )
+    {
+        unsigned int size = read();
+        for( unsigned int j = 0; j < size; j++ )
+        {
+            unsigned int position = read();
+            int literalPosition = read();
+            if( position >= solver.aggregates.size() )
+                corrupted();
+            solver.variableDataStructures[ i ]->variablePropagators.push_back( pair< Propagator*, int >( solver.aggregates[ position ], literalPosition ) );
+        }
+    }
+
+    unsigned int size = read();
+    for( unsigned int i = 0; i < size; i++ )
+    {
+        unsigned int position = read();
+        if( position >= solver.aggregates.size() )
+            corrupted();
+        solver.propagatorsForUnroll.push_back( solver.aggregates[ position ] );
+        solver.aggregates[ position ]->setInVectorOfUnroll( 0 );
+    }
+}
+
+void
+Snapshot::loadComponents()
+{
+    unsigned int size = read();
+    for( unsigned int i = 0; i < size; i++ )
+    {
+        if( !read() )
+        {
+            solver.addGUSData( NULL );
+            continue;
+        }
+
+        GUSData* gusData = new GUSData();
+        readLiterals( gusData->externalLiterals );
+        readLiterals( gusData->internalLiterals );
+        for( unsigned int sign = 0; sign < 2; sign++ )
+        {
+            readVariables( gusData->supportedByThisExternalRule[ sign ] );
+            readVariables( gusData->supportedByThisInternalRule[ sign ] );
+            readVariables( gusData->auxVariablesSupportedByThis[ sign ] );
+            readVariables( gusData->possiblySupportedByThis[ sign ] );
+        }
+        readLiterals( gusData->literals );
+        gusData->numberOfSupporting = read();
+        gusData->sourcePointer = readLiteral();
+        gusData->aux = read();
+        gusData->founded = read();
+        gusData->inQueue = read();
+        gusData->inUnfoundedSet = read();
+        gusData->propagated = read();
+        solver.addGUSData( gusData );
+    }
+
+    unsigned int numberOfComponents = read();
+    for( unsigned int i = 0; i < numberOfComponents; i++ )
+    {
+        Component* component = new Component( solver.gusDataVector, solver );
+        component->setId( i );
+        readVariables( component->variablesInComponent );
+        readVariables( component->variablesWithoutSourcePointer );
+        component->first = read();
+        solver.cyclicComponents.push_back( component );
+    }
+
+    for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+    {
+        unsigned int position = read();
+        if( position > solver.cyclicComponents.size() )
+            corrupted();
+        if( position != 0 )
+            solver.setComponent( v, solver.cyclicComponents[ position - 1 ] );
+    }
+
+    for( unsigned int i = 2; i <= solver.numberOfVariables() * 2 + 1; i++ )
+    {
+        unsigned int size = read();
+        for( unsigned int j = 0; j < size; j++ )
+        {
+            unsigned int position = read();
+            if( position >= solver.cyclicComponents.size() )
+                corrupted();
+            solver.variableDataStructures[ i ]->variablePostPropagators.push_back( solver.cyclicComponents[ position ] );
+        }
+    }
+
+    size = read();
+    for( unsigned int i = 0; i < size; i++ )
+    {
+        unsigned int position = read();
+        if( position >= solver.cyclicComponents.size() )
+            corrupted();
+        solver.addPostPropagator( solver.cyclicComponents[ position ] );
+    }
+}
+
+void
+Snapshot::loadOptimizationLiterals()
+{
+    unsigned int numberOfLevels = read();
+    solver.setLevels( numberOfLevels );
+    for( unsigned int level = 0; level < numberOfLevels; level++ )
+    {
+        if( read() )
+            solver.setWeighted( level );
+        solver.precomputedCosts[ level ] = read64();
+        unsigned int size = read();
+        for( unsigned int i = 0; i < size; i++ )
+        {
+            Literal lit = readLiteral();
+            uint64_t weight = read64();
+            unsigned int flags = read();
+            solver.addOptimizationLiteral( lit, weight, level, flags & 2 );
+            if( flags & 1 )
+                solver.getOptimizationLiteral( level, i ).remove();
+        }
+    }
+    solver.precomputedCost = read64();
+}
+
+void
+Snapshot::read(
+    string& s )
+{
+    uint32_t size = read();
+    const char* data = reinterpret_cast< const char* >( current );
+    unsigned int words = ( size + 3 ) / 4;
+    if( words > static_cast< size_t >( end - current ) )
+        corrupted();
+    s.assign( data, size );
+    current += words;
+}
+
+Clause*
+Snapshot::readClause()
+{
+    uint32_t size = read();
+    if( size > static_cast< size_t >( end - current ) )
+        corrupted();
+    Clause* clause = solver.newClause( size );
+    for( unsigned int i = 0; i < size; i++ )
+    {
+        Literal lit = readLiteral();
+        if( lit.getVariable() == 0 || lit.getVariable() > solver.numberOfVariables() )
+            corrupted();
+        clause->addLiteral( lit );
+    }
+    return clause;
+}
+
+void
+Snapshot::corrupted() const
+{
+    ErrorMessage::errorGeneric( "The snapshot is corrupted." );
+}
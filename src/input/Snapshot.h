@@ -0,0 +1,179 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "../Literal.h"
+#include "../stl/Vector.h"
+#include "../util/Constants.h"
+using namespace std;
+
+class Solver;
+class Clause;
+class Aggregate;
+class Component;
+class GUSData;
+class Propagator;
+class PostPropagator;
+
+#define SNAPSHOT_GRINGO 0
+#define SNAPSHOT_DIMACS 1
+#define SNAPSHOT_MAXSAT 2
+
+/**
+ * Binary image of the solver after preprocessing.
+ * The program is stored as it is when the search starts, so that a later run
+ * can skip parsing, completion and simplifications. The file is versioned and
+ * bound to the machine that wrote it: it is not meant to be exchanged.
+ */
+class Snapshot
+{
+    public:
+        inline Snapshot( Solver& s ) : solver( s ), out( NULL ), file( NULL ), fileSize( 0 ), buffer( NULL ), current( NULL ), end( NULL ) {}
+        ~Snapshot();
+
+        /**
+         * Write the state of the solver in the given file.
+         * 
+         * @param filename the snapshot to create.
+         * @param format the format of the input program.
+         * @return false if the state contains structures which cannot be stored.
+         */
+        bool save( const string& filename, unsigned int format );
+
+        /**
+         * Restore the state of a freshly created solver.
+         * 
+         * @param filename the snapshot to read.
+         * @return the format of the program stored in the snapshot.
+         */
+        unsigned int load( const string& filename );
+
+    private:
+        inline Snapshot( const Snapshot& );
+
+        Solver& solver;
+        FILE* out;
+
+        void* file;
+        size_t fileSize;
+        uint32_t* buffer;
+        const uint32_t* current;
+        const uint32_t* end;
+
+        unordered_map< const Propagator*, unsigned int > propagatorPositions;
+        unordered_map< const PostPropagator*, unsigned int > postPropagatorPositions;
+
+        bool canBeSaved();
+        void saveVariables();
+        void saveClauses();
+        void saveAggregates();
+        void saveComponents();
+        void saveOptimizationLiterals();
+
+        void open( const string& filename );
+        void loadVariables();
+        void loadClauses();
+        void loadAggregates();
+        void loadComponents();
+        void loadOptimizationLiterals();
+
+        inline void write( uint32_t value ) { fwrite( &value, sizeof( uint32_t ), 1, out ); }
+        inline void write64( uint64_t value ) { write( value & 0xffffffff ); write( value >> 32 ); }
+        inline void write( Literal lit ) { write( lit.getIndex() ); }
+        void write( const string& s );
+        void write( const Clause& clause );
+        template< class T > inline void writeVariables( const T& vars );
+        template< class T > inline void writeLiterals( const T& lits );
+        template< class T > inline unsigned int positionOf( const unordered_map< const T*, unsigned int >& positions, const T* element ) const;
+
+        inline uint32_t read() { if( current == end ) corrupted(); return *current++; }
+        inline uint64_t read64() { uint64_t low = read(); return low | ( ( uint64_t ) read() << 32 ); }
+        inline Literal readLiteral();
+        void read( string& s );
+        Clause* readClause();
+        template< class T > inline void readVariables( T& vars );
+        template< class T > inline void readLiterals( T& lits );
+        void corrupted() const;
+};
+
+template< class T >
+void
+Snapshot::writeVariables(
+    const T& vars )
+{
+    write( vars.size() );
+    for( unsigned int i = 0; i < vars.size(); i++ )
+        write( vars[ i ] );
+}
+
+template< class T >
+void
+Snapshot::writeLiterals(
+    const T& lits )
+{
+    write( lits.size() );
+    for( unsigned int i = 0; i < lits.size(); i++ )
+        write( lits[ i ] );
+}
+
+template< class T >
+unsigned int
+Snapshot::positionOf(
+    const unordered_map< const T*, unsigned int >& positions,
+    const T* element ) const
+{
+    typename unordered_map< const T*, unsigned int >::const_iterator it = positions.find( element );
+    assert( it != positions.end() );
+    return it->second;
+}
+
+Literal
+Snapshot::readLiteral()
+{
+    uint32_t index = read();
+    return Literal( index >> 1, index & 1 );
+}
+
+template< class T >
+void
+Snapshot::readVariables(
+    T& vars )
+{
+    uint32_t size = read();
+    for( unsigned int i = 0; i < size; i++ )
+        vars.push_back( read() );
+}
+
+template< class T >
+void
+Snapshot::readLiterals(
+    T& lits )
+{
+    uint32_t size = read();
+    for( unsigned int i = 0; i < size; i++ )
+        lits.push_back( readLiteral() );
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef BINARYMODELREADER_H
+#define BINARYMODELREADER_H
+
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Stream written by --binary-output.
+ * All integers are unsigned LEB128 varints.
+ *
+ * header:  "WASPBIN" version, number of atoms n, then n times (variable, length, name)
+ * records: a tag followed by its data
+ *   'M' model as a bitset of ( n + 7 ) / 8 bytes, bit i of byte i / 8 is atom i
+ *   'D' model as k followed by the k atoms that changed w.r.t. the previous model,
+ *       each one encoded as the difference from the previous atom plus one
+ *   'C' number of levels, then the costs from the highest level to the lowest
+ *   'L' lower bound
+ *   'O' optimum found
+ *   'I' incoherent
+ *   'E' end of the stream
+ *
+ * This header does not depend on the rest of the solver: consumers can include it alone.
+ */
+#define BINARY_MAGIC "WASPBIN"
+#define BINARY_VERSION 1
+#define BINARY_FULL_MODEL 'M'
+#define BINARY_DELTA_MODEL 'D'
+#define BINARY_COST 'C'
+#define BINARY_LOWER_BOUND 'L'
+#define BINARY_OPTIMUM 'O'
+#define BINARY_INCOHERENT 'I'
+#define BINARY_END 'E'
+
+class BinaryModelReader
+{
+    public:
+        explicit BinaryModelReader( FILE* in_ ) : in( in_ ) {}
+
+        inline bool readHeader();
+        inline unsigned int numberOfAtoms() const { return names.size(); }
+        inline const string& getName( unsigned int atom ) const { return names[ atom ]; }
+        inline unsigned int getVariable( unsigned int atom ) const { return variables[ atom ]; }
+
+        /* Reads the next record and returns its tag, or BINARY_END at the end of the stream. */
+        inline int next();
+
+        /* Current model, updated by model records. */
+        inline bool isTrue( unsigned int atom ) const { return model[ atom >> 3 ] & ( 1 << ( atom & 7 ) ); }
+
+        /* Atoms changed by the last model record: all atoms for BINARY_FULL_MODEL records. */
+        inline const vector< unsigned int >& getChangedAtoms() const { return changed; }
+
+        inline const vector< uint64_t >& getCosts() const { return costs; }
+        inline uint64_t getLowerBound() const { return lowerBound; }
+
+    private:
+        inline bool readVarint( uint64_t& value );
+
+        FILE* in;
+        vector< string > names;
+        vector< unsigned int > variables;
+        vector< unsigned char > model;
+        vector< unsigned int > changed;
+        vector< uint64_t > costs;
+        uint64_t lowerBound;
+};
+
+bool
+BinaryModelReader::readVarint(
+    uint64_t& value )
+{
+    value = 0;
+    for( unsigned int shift = 0; shift < 64; shift += 7 )
+    {
+        int c = getc_unlocked( in );
+        if( c == EOF )
+            return false;
+        value |= static_cast< uint64_t >( c & 0x7f ) << shift;
+        if( ( c & 0x80 ) == 0 )
+            return true;
+    }
+    return false;
+}
+
+bool
+BinaryModelReader::readHeader()
+{
+    char magic[ sizeof( BINARY_MAGIC ) ];
+    if( fread( magic, 1, sizeof( magic ), in ) != sizeof( magic ) || string( magic, sizeof( magic ) - 1 ) != BINARY_MAGIC || magic[ sizeof( magic ) - 1 ] != BINARY_VERSION )
+        return false;
+
+    uint64_t n;
+    if( !readVarint( n ) )
+        return false;
+    names.resize( n );
+    variables.resize( n );
+    for( unsigned int i = 0; i < n; i++ )
+    {
+        uint64_t variable, length;
+        if( !readVarint( variable ) || !readVarint( length ) )
+            return false;
+        variables[ i ] = variable;
+        names[ i ].resize( length );
+        if( length > 0 && fread( &names[ i ][ 0 ], 1, length, in ) != length )
+            return false;
+    }
+    model.assign( ( n + 7 ) / 8, 0 );
+    return true;
+}
+
+int
+BinaryModelReader::next()
+{
+    int tag = getc_unlocked( in );
+    uint64_t value;
+    switch( tag )
+    {
+        case BINARY_FULL_MODEL:
+            if( fread( model.data(), 1, model.size(), in ) != model.size() )
+                return BINARY_END;
+            changed.clear();
+            for( unsigned int i = 0; i < names.size(); i++ )
+                changed.push_back( i );
+            return tag;
+
+        case BINARY_DELTA_MODEL:
+        {
+            if( !readVarint( value ) )
+                return BINARY_END;
+            changed.resize( value );
+            uint64_t atom = 0;
+            for( unsigned int i = 0; i < changed.size(); i++ )
+            {
+                if( !readVarint( value ) )
+                    return BINARY_END;
+                atom += value;
+                changed[ i ] = atom - 1;
+                if( changed[ i ] >= names.size() )
+                    return BINARY_END;
+                model[ changed[ i ] >> 3 ] ^= 1 << ( changed[ i ] & 7 );
+            }
+            return tag;
+        }
+
+        case BINARY_COST:
+            if( !readVarint( value ) )
+                return BINARY_END;
+            costs.resize( value );
+            for( unsigned int i = 0; i < costs.size(); i++ )
+                if( !readVarint( costs[ i ] ) )
+                    return BINARY_END;
+            return tag;
+
+        case BINARY_LOWER_BOUND:
+            return readVarint( lowerBound ) ? tag : BINARY_END;
+
+        case BINARY_OPTIMUM:
+        case BINARY_INCOHERENT:
+            return tag;
+
+        default:
+            return BINARY_END;
+    }
+}
+
+#endif
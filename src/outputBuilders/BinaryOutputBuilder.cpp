@@ -0,0 +1,202 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "BinaryOutputBuilder.h"
+#include "BinaryModelReader.h"
+
+#include "../util/VariableNames.h"
+#include <climits>
+#include <cstring>
+
+extern int EXIT_CODE;
+
+void
+BinaryOutputBuilder::writeVarint(
+    uint64_t value )
+{
+    while( value >= 0x80 )
+    {
+        write( static_cast< char >( ( value & 0x7f ) | 0x80 ) );
+        value >>= 7;
+    }
+    write( static_cast< char >( value ) );
+}
+
+unsigned int
+BinaryOutputBuilder::varintSize(
+    uint64_t value )
+{
+    unsigned int size = 1;
+    while( value >= 0x80 )
+    {
+        value >>= 7;
+        size++;
+    }
+    return size;
+}
+
+void
+BinaryOutputBuilder::writeHeader()
+{
+    headerWritten = true;
+    write( BINARY_MAGIC, sizeof( BINARY_MAGIC ) - 1 );
+    write( static_cast< char >( BINARY_VERSION ) );
+    writeVarint( shownVariables.size() );
+    for( unsigned int i = 0; i < shownVariables.size(); i++ )
+    {
+        Var v = shownVariables[ i ];
+        const char* name = VariableNames::getName( v );
+        unsigned int length = strlen( name );
+        writeVarint( v );
+        writeVarint( length );
+        write( name, length );
+
+        if( v >= atomOfVariable.size() )
+            atomOfVariable.resize( v + 1, UINT_MAX );
+        atomOfVariable[ v ] = i;
+    }
+
+    model.assign( ( shownVariables.size() + 7 ) / 8, 0 );
+    previousModel.assign( model.size(), 0 );
+
+    for( unsigned int i = 0; i < lowerBounds.size(); i++ )
+        foundLowerBound( lowerBounds[ i ] );
+    lowerBounds.clear();
+}
+
+void
+BinaryOutputBuilder::startModel()
+{
+    EXIT_CODE = 10;
+    if( !headerWritten )
+        writeHeader();
+    memset( model.data(), 0, model.size() );
+}
+
+void
+BinaryOutputBuilder::printVariable(
+    Var variable,
+    bool isTrue )
+{
+    if( !isTrue || variable >= atomOfVariable.size() || atomOfVariable[ variable ] == UINT_MAX )
+        return;
+    unsigned int atom = atomOfVariable[ variable ];
+    model[ atom >> 3 ] |= 1 << ( atom & 7 );
+}
+
+void
+BinaryOutputBuilder::endModel()
+{
+    changed.clear();
+    unsigned int deltaSize = 0;
+    if( !firstModel )
+    {
+        for( unsigned int i = 0; i < model.size() && deltaSize < model.size(); i++ )
+        {
+            unsigned char difference = model[ i ] ^ previousModel[ i ];
+            while( difference != 0 )
+            {
+                unsigned int atom = ( i << 3 ) + __builtin_ctz( difference );
+                deltaSize += varintSize( changed.empty() ? atom + 1 : atom - changed.back() );
+                changed.push_back( atom );
+                difference &= difference - 1;
+            }
+        }
+        deltaSize += varintSize( changed.size() );
+    }
+
+    if( firstModel || deltaSize >= model.size() )
+    {
+        write( BINARY_FULL_MODEL );
+        write( reinterpret_cast< const char* >( model.data() ), model.size() );
+    }
+    else
+    {
+        write( BINARY_DELTA_MODEL );
+        writeVarint( changed.size() );
+        unsigned int previous = UINT_MAX;
+        for( unsigned int i = 0; i < changed.size(); i++ )
+        {
+            writeVarint( changed[ i ] - previous );
+            previous = changed[ i ];
+        }
+    }
+
+    firstModel = false;
+    model.swap( previousModel );
+    onModelPrinted();
+}
+
+void
+BinaryOutputBuilder::onProgramIncoherent()
+{
+    EXIT_CODE = 20;
+    if( !headerWritten )
+        writeHeader();
+    write( BINARY_INCOHERENT );
+    flush();
+}
+
+void
+BinaryOutputBuilder::foundModelOptimization(
+    const Vector< uint64_t >& costs )
+{
+    write( BINARY_COST );
+    writeVarint( costs.size() );
+    for( int i = costs.size() - 1; i >= 0; --i )
+        writeVarint( costs[ i ] );
+    flush();
+}
+
+void
+BinaryOutputBuilder::optimumFound()
+{
+    EXIT_CODE = 30;
+    write( BINARY_OPTIMUM );
+    flush();
+}
+
+void
+BinaryOutputBuilder::foundLowerBound(
+    uint64_t lb )
+{
+    //The header requires the shown atoms, which are known when the first model is printed.
+    if( !headerWritten )
+    {
+        lowerBounds.push_back( lb );
+        return;
+    }
+    write( BINARY_LOWER_BOUND );
+    writeVarint( lb );
+    flush();
+}
+
+void
+BinaryOutputBuilder::onFinish()
+{
+    if( !headerWritten )
+        writeHeader();
+    write( BINARY_END );
+    flush();
+}
+
+void
+BinaryOutputBuilder::onKill()
+{
+    onFinish();
+}
@@ -0,0 +1,63 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef BINARYOUTPUTBUILDER_H
+#define BINARYOUTPUTBUILDER_H
+
+#include "OutputBuilder.h"
+#include <vector>
+using namespace std;
+
+/**
+ * Writes the stream decoded by BinaryModelReader.
+ * Each model is written either as a bitset over the shown atoms or as the
+ * list of atoms changed since the previous model, whichever is smaller.
+ */
+class BinaryOutputBuilder : public OutputBuilder
+{
+    public:
+        inline BinaryOutputBuilder();
+        virtual void startModel();
+        virtual void printVariable( Var v, bool isTrue );
+        virtual void endModel();
+        virtual void onProgramIncoherent();
+        virtual void foundModelOptimization( const Vector< uint64_t >& costs );
+        virtual void optimumFound();
+        virtual void foundLowerBound( uint64_t lb );
+        virtual void onFinish();
+        virtual void onKill();
+
+    private:
+        void writeHeader();
+        void writeVarint( uint64_t value );
+        static unsigned int varintSize( uint64_t value );
+
+        bool headerWritten;
+        bool firstModel;
+        vector< unsigned int > atomOfVariable;
+        vector< unsigned char > model;
+        vector< unsigned char > previousModel;
+        vector< unsigned int > changed;
+        vector< uint64_t > lowerBounds;
+};
+
+BinaryOutputBuilder::BinaryOutputBuilder() : headerWritten( false ), firstModel( true )
+{
+}
+
+#endif
@@ -25,7 +25,7 @@ void
 CompetitionOutputBuilder::startModel()
 {
     EXIT_CODE = 10;
-    cout << ANSWER << endl;
+    write( ANSWER "\n" );
 }
 
 void
@@ -37,19 +37,22 @@ CompetitionOutputBuilder::printVariable(
         return;
     if( isTrue )
     {
-        cout << VariableNames::getName( variable ) << ". ";
+        write( VariableNames::getName( variable ) );
+        write( ". ", 2 );
     }    
 }
 
 void
 CompetitionOutputBuilder::endModel()
 {
-    cout << endl;
+    write( '\n' );
+    onModelPrinted();
 }
 
 void
 CompetitionOutputBuilder::onProgramIncoherent()
 {
     EXIT_CODE = 20;
-    cout << NOMODEL_COMPETITION_OUTPUT << endl;
+    write( NOMODEL_COMPETITION_OUTPUT "\n" );
+    flush();
 }
\ No newline at end of file
@@ -29,10 +29,16 @@ DimacsOutputBuilder::startModel()
 {
     EXIT_CODE = 10;
     if( ++numberOfModels == 1 && !maxsat )
-        cout << SOLUTION_DIMACS << " " << SAT << endl;
+    {
+        write( SOLUTION_DIMACS );
+        write( " " SAT "\n" );
+    }
     
-    cout << COMMENT_DIMACS << " solution " << numberOfModels << endl;    
-    cout << VALUE_DIMACS;
+    write( COMMENT_DIMACS );
+    write( " solution " );
+    writeNumber( numberOfModels );
+    write( '\n' );
+    write( VALUE_DIMACS );
 }
 
 void 
@@ -42,26 +48,42 @@ DimacsOutputBuilder::printVariable(
 {
     if( !VariableNames::hasToBePrinted( v ) )
         return;
-    cout << ( isTrue ? " " : " -" ) << v;    
+    if( isTrue )
+        write( ' ' );
+    else
+        write( " -", 2 );
+    writeNumber( v );
 }
 
 void
 DimacsOutputBuilder::endModel()
 {
-    cout << endl;
+    write( '\n' );
+    onModelPrinted();
 }
 
 void
 DimacsOutputBuilder::onProgramIncoherent()
 {
     EXIT_CODE = 20;
-    cout << SOLUTION_DIMACS << " " << UNSAT << endl;
+    write( SOLUTION_DIMACS );
+    write( " " UNSAT "\n" );
+    flush();
+}
+
+bool
+DimacsOutputBuilder::isShown(
+    Var v ) const
+{
+    return VariableNames::hasToBePrinted( v );
 }
 
 void
 DimacsOutputBuilder::greetings()
 {
-    cout << COMMENT_DIMACS << " " << WASP_STRING;
+    write( COMMENT_DIMACS );
+    write( " " WASP_STRING );
+    flush();
 }
 
 void
@@ -69,19 +91,29 @@ DimacsOutputBuilder::foundModelOptimization(
     const Vector< uint64_t >& costs )
 {
     assert( costs.size() == 1 );
-    cout << OPTIMUM_DIMACS << " " << costs[ 0 ] << endl;
+    write( OPTIMUM_DIMACS );
+    write( ' ' );
+    writeNumber( costs[ 0 ] );
+    write( '\n' );
+    flush();
 }
 
 void
 DimacsOutputBuilder::optimumFound()
 {
     EXIT_CODE = 10;
-    cout << SOLUTION_DIMACS << " " << OPTIMUM_FOUND_DIMACS << endl;    
+    write( SOLUTION_DIMACS );
+    write( " " OPTIMUM_FOUND_DIMACS "\n" );
+    flush();
 }
 
 void
 DimacsOutputBuilder::foundLowerBound(
     uint64_t lb )
 {
-    cout << OPTIMUM_DIMACS << " " << lb << endl;
+    write( OPTIMUM_DIMACS );
+    write( ' ' );
+    writeNumber( lb );
+    write( '\n' );
+    flush();
 }
\ No newline at end of file
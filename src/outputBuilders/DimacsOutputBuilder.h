@@ -35,6 +35,10 @@ class DimacsOutputBuilder : public OutputBuilder
         virtual void foundLowerBound( uint64_t );
     
         inline void setMaxsat() { maxsat = true; }
+
+    protected:
+        virtual bool isShown( Var v ) const;
+
     private:
         unsigned int numberOfModels;
         bool maxsat;
@@ -17,22 +17,41 @@
  */
 
 #include "OutputBuilder.h"
+
+#include "../util/Options.h"
+#include "../util/VariableNames.h"
+
+#include <cerrno>
+#include <unistd.h>
 extern int EXIT_CODE;
 
+OutputBuilder::~OutputBuilder()
+{
+    flush();
+    delete [] buffer;
+}
+
 void
 OutputBuilder::foundModelOptimization(
     const Vector< uint64_t >& costs )
 {     
-    cout << COST;
+    write( COST );
     for( int i = costs.size() - 1; i >= 0; --i )
-        cout << " " << costs[ i ] << WEIGHT_LEVEL_WEAKCONSTRAINT_SEPARATOR << ( i + 1 );
-    cout << endl;    
+    {
+        write( ' ' );
+        writeNumber( costs[ i ] );
+        write( WEIGHT_LEVEL_WEAKCONSTRAINT_SEPARATOR );
+        writeNumber( i + 1 );
+    }
+    write( '\n' );
+    flush();
 }
 
 void
 OutputBuilder::optimumFound()
 {
-    cout << OPTIMUM_STRING << endl;
+    write( OPTIMUM_STRING "\n" );
+    flush();
     EXIT_CODE = 30;
 }
 
@@ -45,9 +64,100 @@ OutputBuilder::foundLowerBound(
 void
 OutputBuilder::onFinish()
 {
+    flush();
 }
 
 void
 OutputBuilder::onKill()
 {
-}
\ No newline at end of file
+    flush();
+}
+
+const Vector< Var >&
+OutputBuilder::getShownVariables(
+    unsigned int numberOfVariables )
+{
+    if( !shownVariablesComputed )
+    {
+        shownVariablesComputed = true;
+        for( Var v = 1; v <= numberOfVariables; v++ )
+            if( isShown( v ) )
+                shownVariables.push_back( v );
+    }
+    return shownVariables;
+}
+
+bool
+OutputBuilder::isShown(
+    Var v ) const
+{
+    return !VariableNames::isHidden( v );
+}
+
+void
+OutputBuilder::writeNumber(
+    uint64_t number )
+{
+    char ciphers[ 20 ];
+    unsigned int i = 20;
+    do
+    {
+        ciphers[ --i ] = '0' + number % 10;
+        number /= 10;
+    } while( number != 0 );
+    write( ciphers + i, 20 - i );
+}
+
+void
+OutputBuilder::onModelPrinted()
+{
+    if( ++modelsToFlush >= wasp::Options::modelsPerFlush && wasp::Options::modelsPerFlush != 0 )
+        flush();
+}
+
+void
+OutputBuilder::writeLarge(
+    const char* s,
+    unsigned int length )
+{
+    if( buffer == NULL )
+        buffer = new char[ OUTPUT_BUFFER_SIZE ];
+
+    while( bufferSize + length > OUTPUT_BUFFER_SIZE )
+    {
+        unsigned int chunk = OUTPUT_BUFFER_SIZE - bufferSize;
+        memcpy( buffer + bufferSize, s, chunk );
+        bufferSize += chunk;
+        s += chunk;
+        length -= chunk;
+        flush();
+    }
+
+    memcpy( buffer + bufferSize, s, length );
+    bufferSize += length;
+}
+
+void
+OutputBuilder::flush()
+{
+    modelsToFlush = 0;
+    if( bufferSize == 0 )
+        return;
+
+    //Anything printed through cout must precede the content of the buffer.
+    cout.flush();
+    const char* data = buffer;
+    while( bufferSize > 0 )
+    {
+        ssize_t bytes = ::write( STDOUT_FILENO, data, bufferSize );
+        if( bytes < 0 )
+        {
+            if( errno == EINTR )
+                continue;
+            break;
+        }
+        data += bytes;
+        bufferSize -= bytes;
+    }
+    bufferSize = 0;
+}
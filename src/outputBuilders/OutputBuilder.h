@@ -22,13 +22,20 @@
 #include "../util/Constants.h"
 #include "../stl/Vector.h"
 
+#include <cstring>
 #include <iostream>
 using namespace std;
 
+/**
+ * Models are formatted in a reusable buffer, which is written to the
+ * standard output with a single system call per model or per batch of
+ * models (see --flush-models).
+ */
 class OutputBuilder
 {
     public:
-        virtual ~OutputBuilder() {}
+        inline OutputBuilder();
+        virtual ~OutputBuilder();
         virtual void startModel() = 0;
         virtual void printVariable( Var v, bool isTrue ) = 0;
         virtual void endModel() = 0;
@@ -39,6 +46,71 @@ class OutputBuilder
         virtual void foundLowerBound( uint64_t );
         virtual void onFinish();
         virtual void onKill();
+
+        /**
+         * Variables passed to printVariable when a model is printed.
+         * The list is computed the first time, when names are final.
+         */
+        const Vector< Var >& getShownVariables( unsigned int numberOfVariables );
+
+    protected:
+        virtual bool isShown( Var v ) const;
+
+        inline void write( const char* s, unsigned int length );
+        inline void write( const char* s ) { write( s, strlen( s ) ); }
+        inline void write( char c );
+        void writeNumber( uint64_t number );
+
+        /* Counts the printed models and flushes according to --flush-models. */
+        void onModelPrinted();
+        void flush();
+
+        Vector< Var > shownVariables;
+
+    private:
+        OutputBuilder( const OutputBuilder& );
+        OutputBuilder& operator=( const OutputBuilder& );
+
+        void writeLarge( const char* s, unsigned int length );
+
+        char* buffer;
+        unsigned int bufferSize;
+        unsigned int modelsToFlush;
+        bool shownVariablesComputed;
 };
 
+#define OUTPUT_BUFFER_SIZE ( 1 << 20 )
+
+OutputBuilder::OutputBuilder() : buffer( NULL ), bufferSize( 0 ), modelsToFlush( 0 ), shownVariablesComputed( false )
+{
+}
+
+void
+OutputBuilder::write(
+    const char* s,
+    unsigned int length )
+{
+    if( buffer == NULL || bufferSize + length > OUTPUT_BUFFER_SIZE )
+    {
+        writeLarge( s, length );
+        return;
+    }
+
+    memcpy( buffer + bufferSize, s, length );
+    bufferSize += length;
+}
+
+void
+OutputBuilder::write(
+    char c )
+{
+    if( buffer == NULL || bufferSize == OUTPUT_BUFFER_SIZE )
+    {
+        writeLarge( &c, 1 );
+        return;
+    }
+
+    buffer[ bufferSize++ ] = c;
+}
+
 #endif
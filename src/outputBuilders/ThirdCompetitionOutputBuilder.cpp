@@ -21,7 +21,7 @@
 void
 ThirdCompetitionOutputBuilder::startModel()
 {
-    cout << ANSWER_THIRD_COMPETITION << endl;
+    write( ANSWER_THIRD_COMPETITION "\n" );
 }
 
 void
@@ -33,18 +33,21 @@ ThirdCompetitionOutputBuilder::printVariable(
         return;
     if( isTrue )
     {
-        cout << VariableNames::getName( variable ) << ". ";
+        write( VariableNames::getName( variable ) );
+        write( ". ", 2 );
     }
 }
 
 void
 ThirdCompetitionOutputBuilder::endModel()
 {
-    cout << endl;
+    write( '\n' );
+    onModelPrinted();
 }
 
 void
 ThirdCompetitionOutputBuilder::onProgramIncoherent()
 {
-    cout << NOMODEL_COMPETITION_OUTPUT << endl;
+    write( NOMODEL_COMPETITION_OUTPUT "\n" );
+    flush();
 }
\ No newline at end of file
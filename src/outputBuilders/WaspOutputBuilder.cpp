@@ -26,7 +26,7 @@ void
 WaspOutputBuilder::startModel()
 {
     first = true;
-    cout << "{";
+    write( '{' );
 }
 
 void
@@ -40,28 +40,31 @@ WaspOutputBuilder::printVariable(
     if( isTrue )
     {
         if( !first )
-            cout << ", ";
+            write( ", ", 2 );
         else
             first = false;
 
-        cout << VariableNames::getName( variable );
+        write( VariableNames::getName( variable ) );
     }
 }
 
 void
 WaspOutputBuilder::endModel()
 {
-    cout << "}" << endl;
+    write( "}\n", 2 );
+    onModelPrinted();
 }
 
 void
 WaspOutputBuilder::onProgramIncoherent()
 {
-     cout << NOMODEL << endl;
+    write( NOMODEL "\n" );
+    flush();
 }
 
 void
 WaspOutputBuilder::greetings()
 {
-    cout << WASP_STRING << endl;
+    write( WASP_STRING "\n" );
+    flush();
 }
\ No newline at end of file
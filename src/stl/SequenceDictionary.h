@@ -0,0 +1,156 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+
+#ifndef _SEQUENCEDICTIONARY_H
+#define _SEQUENCEDICTIONARY_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include "Vector.h"
+using namespace std;
+
+/**
+ * Hash-consing of integer sequences, used to detect duplicate rules.
+ * The first element of a sequence is its key (the head of a rule), the others
+ * form a set (the body) and are sorted before the lookup. All sequences are
+ * stored in one arena, and the table uses open addressing with linear probing.
+ */
+class SequenceDictionary
+{
+    public:
+        inline SequenceDictionary() : numberOfSequences( 0 ), disabled( false ) { table.resize( 1024 ); }
+
+        inline void clear();
+        inline void disable() { clear(); disabled = true; }
+
+        inline void startInsertion() { if( !disabled ) current.clear(); }
+        inline void addElement( int element ) { if( !disabled ) current.push_back( element ); }
+
+        /**
+         * Close the current sequence.
+         * 
+         * @return true if the sequence was already in the dictionary.
+         */
+        inline bool endInsertion();
+
+    private:
+        struct Slot
+        {
+            uint32_t hash;
+            //Position of the sequence in the arena plus one: 0 marks an empty slot.
+            uint32_t position;
+        };
+
+        Vector< int > arena;
+        vector< Slot > table;
+        Vector< int > current;
+        unsigned int numberOfSequences;
+        bool disabled;
+
+        inline uint32_t hash() const;
+        inline bool equals( uint32_t position ) const;
+        inline void grow();
+};
+
+void
+SequenceDictionary::clear()
+{
+    arena.clearAndDelete();
+    current.clearAndDelete();
+    vector< Slot >().swap( table );
+    table.resize( 1024 );
+    numberOfSequences = 0;
+}
+
+bool
+SequenceDictionary::endInsertion()
+{
+    if( disabled )
+        return false;
+
+    assert( !current.empty() );
+    int* begin = &current[ 0 ];
+    sort( begin + 1, begin + current.size() );
+    current.shrink( unique( begin + 1, begin + current.size() ) - begin );
+
+    uint32_t h = hash();
+    uint32_t mask = table.size() - 1;
+    uint32_t i = h & mask;
+    for( ; table[ i ].position != 0; i = ( i + 1 ) & mask )
+    {
+        if( table[ i ].hash == h && equals( table[ i ].position - 1 ) )
+            return true;
+    }
+
+    table[ i ].hash = h;
+    table[ i ].position = arena.size() + 1;
+    arena.push_back( current.size() );
+    for( unsigned int j = 0; j < current.size(); j++ )
+        arena.push_back( current[ j ] );
+
+    //Keep the load factor below 3/4.
+    if( ++numberOfSequences * 4 >= table.size() * 3 )
+        grow();
+    return false;
+}
+
+uint32_t
+SequenceDictionary::hash() const
+{
+    uint32_t h = 2166136261u;
+    for( unsigned int i = 0; i < current.size(); i++ )
+        h = ( h ^ static_cast< uint32_t >( current[ i ] ) ) * 16777619u;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return h;
+}
+
+bool
+SequenceDictionary::equals(
+    uint32_t position ) const
+{
+    if( static_cast< unsigned int >( arena[ position ] ) != current.size() )
+        return false;
+    for( unsigned int i = 0; i < current.size(); i++ )
+        if( arena[ position + 1 + i ] != current[ i ] )
+            return false;
+    return true;
+}
+
+void
+SequenceDictionary::grow()
+{
+    vector< Slot > old( table.size() * 2 );
+    old.swap( table );
+    uint32_t mask = table.size() - 1;
+    for( unsigned int i = 0; i < old.size(); i++ )
+    {
+        if( old[ i ].position == 0 )
+            continue;
+        uint32_t j = old[ i ].hash & mask;
+        while( table[ j ].position != 0 )
+            j = ( j + 1 ) & mask;
+        table[ j ] = old[ i ];
+    }
+}
+
+#endif
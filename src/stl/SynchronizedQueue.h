@@ -0,0 +1,80 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef SYNCHRONIZEDQUEUE_H
+#define SYNCHRONIZEDQUEUE_H
+
+#include <cassert>
+#include <mutex>
+#include "Vector.h"
+using namespace std;
+
+/**
+ * A LIFO queue that can be filled concurrently by several threads.
+ * Elements are consumed by a single thread through tryPop.
+ */
+template< class T >
+class SynchronizedQueue
+{
+    public:
+        inline SynchronizedQueue() {}
+        inline ~SynchronizedQueue() {}
+
+        inline void push( T element );
+        inline bool tryPop( T& element );
+        inline bool empty();
+
+    private:
+        SynchronizedQueue( const SynchronizedQueue< T >& );
+        SynchronizedQueue< T >& operator=( const SynchronizedQueue< T >& );
+
+        Vector< T > elements;
+        mutex lock;
+};
+
+template< class T >
+void
+SynchronizedQueue< T >::push(
+    T element )
+{
+    lock_guard< mutex > guard( lock );
+    elements.push_back( element );
+}
+
+template< class T >
+bool
+SynchronizedQueue< T >::tryPop(
+    T& element )
+{
+    lock_guard< mutex > guard( lock );
+    if( elements.empty() )
+        return false;
+    element = elements.back();
+    elements.pop_back();
+    return true;
+}
+
+template< class T >
+bool
+SynchronizedQueue< T >::empty()
+{
+    lock_guard< mutex > guard( lock );
+    return elements.empty();
+}
+
+#endif
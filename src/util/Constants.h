@@ -49,6 +49,7 @@
 #define SILENT_OUTPUT 3
 #define THIRD_COMPETITION_OUTPUT 4
 #define MULTI 5
+#define BINARY_OUTPUT 6
 
 #define SEQUENCE_BASED_RESTARTS_POLICY 0
 #define GEOMETRIC_RESTARTS_POLICY 1
@@ -58,6 +59,14 @@
 #define NO_QUERY 0
 #define OVERESTIMATE_REDUCTION 1
 #define ITERATIVE_COHERENCE_TESTING 2
+#define BRAVE_CONSEQUENCES 3
+#define CORE_BASED_CHUNKING 4
+
+#define CORE_BASED_CHUNKING_GROUPS 2
+#define CORE_BASED_CHUNKING_MAX_GROUP_SIZE 256
+
+#define ENUMERATION_BLOCKING_CLAUSES 0
+#define ENUMERATION_BACKTRACKING 1
 
 #define OPT 0
 #define MGD 1
@@ -24,7 +24,7 @@ string
 Formatter::formatLiteral(
     const Literal& literal )
 {
-    return (literal.isNegative() ? "-" : "") + VariableNames::getName( literal.getVariable() );
+    return string( literal.isNegative() ? "-" : "" ) + VariableNames::getName( literal.getVariable() );
 }
 
 string
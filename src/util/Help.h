@@ -68,6 +68,8 @@ class Help
             cout << "--third-competition-output             - Print models according to the third competition output" << endl;
             cout << "--competition-output                   - Print models according to the fourth competition output" << endl;   
             cout << "--printlatestmodel                     - Print the latest computed model" << endl;   
+            cout << "--binary-output                        - Print models as a binary stream (see BinaryModelReader.h)" << endl;
+            cout << "--flush-models=<n>                     - Write models in batches of n (0: only when the buffer is full)" << endl;
             cout << separator << endl;
             
             cout << "Heuristics options                     " << endl << endl;
@@ -77,11 +79,16 @@ class Help
             cout << "--heuristic-minisat                    - Enable minisat heuristic" << endl;
             cout << separator << endl;
 
+            cout << "Propagation options                    " << endl << endl;
+            cout << "--aggregate-watch-size=<n>             - Watch only a subset of the literals of aggregates with at least n literals (default 256, 0: disabled)" << endl;
+            cout << separator << endl;
+
             cout << "Model Checker options                  " << endl << endl;
             cout << "--exchange-clauses                     - Exchange clauses from checker to generator" << endl;
             cout << "--forward-partialchecks                - Enable forward partial checks" << endl;
             cout << "--backward-partialchecks               - Enable backward partial checks" << endl;
             cout << "--bump-activity-partialchecks          - Bump activity after partial checks" << endl;
+            cout << "--modelchecker-threads=<n>             - Check independent head-cycle components using n threads" << endl;
                 
             cout << separator << endl;
             cout << "Weak Constraints options               " << endl << endl;
@@ -96,6 +103,14 @@ class Help
             cout << "--enable-disjcores                     - Enable disjoint cores preprocessing (only for core-guided)" << endl;
             cout << "--minimize-unsatcore                   - Enable minimization of unsat cores (only for core-guided)" << endl;
             cout << "--disable-stratification               - Disable stratification (only for core-guided)" << endl;
+            cout << "--enable-totalizer                     - Encode cores by incremental totalizers (only for oll)" << endl;
+            cout << "--trim-core                            - Shrink unsat cores by solving under their own assumptions (only for core-guided)" << endl;
+            cout << "--exhaust-core                         - Increase the bound of new cores while they remain unsat (only for oll)" << endl;
+            cout << "--core-budget=<n>                      - Conflicts allowed for each call of core trimming, exhaustion, repair of local search and neighbourhoods (default 1000)" << endl;
+            cout << "--local-search=<flips>                 - Look for upper bounds by local search before solving each level (default 100000 flips)" << endl;
+            cout << "--local-search-period=<n>              - Run local search again every n cores (default 50, only for oll and pmres)" << endl;
+            cout << "--solution-guided                      - Use the best model as phase of the heuristic (only for basic and opt)" << endl;
+            cout << "--lns=<percent>                        - Explore neighbourhoods of the best model fixing a percentage of its variables (default 50, only for basic and opt)" << endl;
             cout << "--compute-firstmodel=budget            - Compute a model before starting the algorithm. In addition, budget may specify the maximum number of seconds allowed." << endl;
 
             cout << separator << endl;
@@ -103,11 +118,21 @@ class Help
             cout << "--query-algorithm                      - Compute cautious consequences according to the specified algorithm" << endl;
             cout << "       =ict                            - Enable iterative coherence testing" << endl;
             cout << "       =or                             - Enable overestimate reduction" << endl;
+            cout << "       =cb                             - Enable core-based chunking" << endl;
+            cout << "       =brave                          - Compute brave consequences instead" << endl;
             cout << "--query-verbosity=(0,1,2)              - Enable verbosity of queries algorithms" << endl;
+            cout << "--query-chunk-size=<n>                 - Initial number of candidates in each group of core-based chunking (default 8)" << endl;
 
             cout << separator << endl;
             cout << "General options                        " << endl << endl;
             cout << "--dimacs                               - Enable dimacs format as input and outputs" << endl;
+            cout << "--lazy-symbol-table                    - Parse atom names only when a model is printed" << endl;
+            cout << "--enumeration=<strategy>               - Strategy used to enumerate models" << endl;
+            cout << "       =bc                             - Add a clause blocking each model and restart (default)" << endl;
+            cout << "       =bt                             - Backtrack on the last decision and flip it" << endl;
+            cout << "--project[=<file>]                     - Enumerate models projected on shown atoms, or on the atoms listed in file (one per line)" << endl;
+            cout << "--save-snapshot=<file>                 - Store the preprocessed program in file" << endl;
+            cout << "--load-snapshot=<file>                 - Read the preprocessed program from file instead of the input" << endl;
             cout << "--help                                 - Print this guide and exit" << endl;
 //            cout << "--stdin                                - Write a description." << endl;
 //            cout << "--time-limit                           - Write a description." << endl;
@@ -0,0 +1,138 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+
+#include "Istream.h"
+
+#include <cerrno>
+#include <unistd.h>
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define ISTREAM_MMAP
+#endif
+
+#define ISTREAM_BUFFER_SIZE ( 1 << 20 )
+
+Istream::Istream(
+    istream& in_ ) : in( &in_ ), fileDescriptor( -1 ), buffer( new char[ ISTREAM_BUFFER_SIZE ] ), mappedFile( NULL ), mappedSize( 0 ), current( NULL ), end( NULL ), exhausted( false )
+{
+    current = end = buffer;
+}
+
+Istream::Istream(
+    int fileDescriptor_ ) : in( NULL ), fileDescriptor( fileDescriptor_ ), buffer( NULL ), mappedFile( NULL ), mappedSize( 0 ), current( NULL ), end( NULL ), exhausted( false )
+{
+    #ifdef ISTREAM_MMAP
+    struct stat info;
+    if( fstat( fileDescriptor, &info ) == 0 && S_ISREG( info.st_mode ) && info.st_size > 0 )
+    {
+        //Part of the file might have been consumed already.
+        off_t offset = lseek( fileDescriptor, 0, SEEK_CUR );
+        void* file = mmap( NULL, info.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+        if( file != MAP_FAILED && offset >= 0 && offset <= info.st_size )
+        {
+            madvise( file, info.st_size, MADV_SEQUENTIAL );
+            mappedFile = static_cast< char* >( file );
+            mappedSize = info.st_size;
+            current = mappedFile + offset;
+            end = mappedFile + mappedSize;
+            exhausted = true;
+            return;
+        }
+
+        if( file != MAP_FAILED )
+            munmap( file, info.st_size );
+    }
+    #endif
+
+    buffer = new char[ ISTREAM_BUFFER_SIZE ];
+    current = end = buffer;
+}
+
+Istream::~Istream()
+{
+    #ifdef ISTREAM_MMAP
+    if( mappedFile != NULL )
+        munmap( mappedFile, mappedSize );
+    #endif
+    delete [] buffer;
+}
+
+bool
+Istream::fill()
+{
+    if( exhausted )
+        return false;
+
+    long int bytes;
+    if( in != NULL )
+    {
+        in->read( buffer, ISTREAM_BUFFER_SIZE );
+        bytes = in->gcount();
+    }
+    else
+    {
+        do
+        {
+            bytes = ::read( fileDescriptor, buffer, ISTREAM_BUFFER_SIZE );
+        } while( bytes < 0 && errno == EINTR );
+    }
+
+    if( bytes <= 0 )
+    {
+        exhausted = true;
+        current = end = buffer;
+        return false;
+    }
+
+    current = buffer;
+    end = buffer + bytes;
+    return true;
+}
+
+/**
+ * Appends whole lines to lines until a line equal to terminator is found.
+ * The terminating line is consumed but not copied.
+ */
+void
+Istream::copyLinesUntil(
+    const string& terminator,
+    string& lines )
+{
+    size_t lineStart = lines.size();
+    while( current != end || fill() )
+    {
+        const char* newLine = static_cast< const char* >( memchr( current, '\n', end - current ) );
+        if( newLine == NULL )
+        {
+            lines.append( current, end - current );
+            current = end;
+            continue;
+        }
+
+        lines.append( current, newLine - current + 1 );
+        current = newLine + 1;
+        if( lines.size() - lineStart == terminator.size() + 1 && lines.compare( lineStart, terminator.size(), terminator ) == 0 )
+        {
+            lines.resize( lineStart );
+            return;
+        }
+        lineStart = lines.size();
+    }
+}
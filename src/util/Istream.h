@@ -19,152 +19,200 @@
 #ifndef ISTREAM_H
 #define ISTREAM_H
 
+#include <cassert>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <stdint.h>
 
 using namespace std;
 
+/**
+ * Regular files are memory mapped and parsed in place.
+ * Pipes, terminals and C++ streams are read in large blocks.
+ */
 class Istream
 {
     public:
-        explicit inline Istream( istream& in_ ) : in( in_ ), idx( 0 ) { buff[ 0 ] = '\0';  in.read( buff, 2047 ); buff[ in.gcount() ] = '\0'; }
+        explicit Istream( istream& in_ );
+        explicit Istream( int fileDescriptor_ );
+        ~Istream();
+
         inline char next();
+        inline char peek();
         inline bool read( unsigned int& value );
         inline bool read( uint64_t& value );
         inline bool read( int& value );
         inline bool read( string& value );
         inline void read( char& value );
         inline void getline( char* buff, unsigned size );
+        void copyLinesUntil( const string& terminator, string& lines );
         inline bool readInfoDimacs( unsigned int& numberOfVariables, unsigned int& numberOfClauses, uint64_t& maxWeight );        
-        inline bool eof(){ return buff[ 0 ] == EOF; }
+        inline bool eof() const { return current == end && exhausted; }
 
     private:
+        Istream( const Istream& );
+        Istream& operator=( const Istream& );
+
         inline void skipBlanksAndComments();
         inline void skipBlanks();
         inline bool isCipher( char c ) const { return '0' <= c && c <= '9'; }
         inline bool isBlank( char c ) const;
-        inline void resetBuffer();
+        inline bool readNumber( uint64_t& value );
+        inline unsigned int readEightCiphers( uint64_t& value ) const;
+        bool fill();
 
-        istream& in;
-        char buff[ 2048 ];
-        unsigned idx;
+        istream* in;
+        int fileDescriptor;
+        char* buffer;
+        char* mappedFile;
+        size_t mappedSize;
+        const char* current;
+        const char* end;
+        bool exhausted;
 };
 
-void
-Istream::resetBuffer()
+char
+Istream::next()
 {
-    idx = 0;
-    if( in )
-    {
-        in.read( buff, 2047 );
-        buff[ in.gcount() ] = '\0';
-    }
-    else
-    {
-        buff[ 0 ] = EOF;
-    }
+    if( current == end && !fill() )
+        return EOF;
+    return *current++;
 }
 
 char
-Istream::next()
+Istream::peek()
 {
-    if( buff[ idx ] == '\0' )
-        resetBuffer();
-    return buff[ idx++ ];
+    skipBlanks();
+    if( current == end && !fill() )
+        return EOF;
+    return *current;
+}
+
+unsigned int
+Istream::readEightCiphers(
+    uint64_t& value ) const
+{
+    assert( end - current >= 8 );
+    #if defined( __GNUC__ ) && defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t word;
+    memcpy( &word, current, 8 );
+
+    //A byte is not a cipher if its high nibble is not 3 or its low nibble is greater than 9.
+    uint64_t notCiphers = ( ( word ^ 0x3030303030303030ULL ) | ( ( word & 0x0F0F0F0F0F0F0F0FULL ) + 0x0606060606060606ULL ) ) & 0xF0F0F0F0F0F0F0F0ULL;
+    notCiphers = ( ( notCiphers >> 4 ) + 0x7F7F7F7F7F7F7F7FULL ) & 0x8080808080808080ULL;
+    unsigned int ciphers = notCiphers == 0 ? 8 : __builtin_ctzll( notCiphers ) >> 3;
+    if( ciphers == 0 )
+        return 0;
+
+    //Bytes after the last cipher are shifted out, the missing ciphers become leading zeros.
+    word = ( word - 0x3030303030303030ULL ) << ( ( 8 - ciphers ) << 3 );
+    word = ( ( word & 0x0F0F0F0F0F0F0F0FULL ) * 2561 ) >> 8;
+    word = ( ( word & 0x00FF00FF00FF00FFULL ) * 6553601 ) >> 16;
+    value = ( ( word & 0x0000FFFF0000FFFFULL ) * 42949672960001ULL ) >> 32;
+    return ciphers;
+    #else
+    unsigned int ciphers = 0;
+    value = 0;
+    while( ciphers < 8 && isCipher( current[ ciphers ] ) )
+        value = value * 10 + ( current[ ciphers++ ] - '0' );
+    return ciphers;
+    #endif
 }
 
 bool
-Istream::read(
-    int& value )
+Istream::readNumber(
+    uint64_t& value )
 {
-    skipBlanksAndComments();
+    if( current == end && !fill() )
+        return false;
 
-    int sign = 1;
-    char c = next();    
-    if( c == '-' )
+    if( !isCipher( *current ) )
     {
-        sign = -1;        
-        c = next();
+        ++current;
+        return false;
     }
 
-    if( !isCipher( c ) )
-        return false;
-    value = c - '0';    
+    static const uint64_t powersOfTen[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+    value = 0;
     while( true )
     {
-        c = next();    
-        if( !isCipher( c ) )
+        if( end - current >= 8 )
         {
-            value *= sign;
-            return true;
+            uint64_t chunk = 0;
+            unsigned int ciphers = readEightCiphers( chunk );
+            value = value * powersOfTen[ ciphers ] + chunk;
+            current += ciphers;
+            if( ciphers < 8 )
+            {
+                //As in the character by character reading, the delimiter is consumed.
+                ++current;
+                return true;
+            }
+            continue;
         }
+
+        char c = next();
+        if( !isCipher( c ) )
+            return true;
         value *= 10;
         value += c - '0';
     }
-    
-    return true;
 }
 
 bool
 Istream::read(
-    unsigned int& value )
+    int& value )
 {
     skipBlanksAndComments();
 
-    char c = next();    
-
-    if( !isCipher( c ) )
-        return false;
-    value = c - '0';
-    while( true )
+    int sign = 1;
+    if( ( current != end || fill() ) && *current == '-' )
     {
-        c = next();
-        if( !isCipher( c ) )
-        {
-            return true;
-        }
-        value *= 10;
-        value += c - '0';
+        sign = -1;
+        ++current;
     }
-    
+
+    uint64_t absoluteValue;
+    if( !readNumber( absoluteValue ) )
+        return false;
+    value = sign * static_cast< int >( absoluteValue );
     return true;
 }
 
 bool
 Istream::read(
-    uint64_t& value )
+    unsigned int& value )
 {
     skipBlanksAndComments();
 
-    char c = next();    
-
-    if( !isCipher( c ) )
+    uint64_t tmp;
+    if( !readNumber( tmp ) )
         return false;
-    value = c - '0';
-    while( true )
-    {
-        c = next();
-        if( !isCipher( c ) )
-        {
-            return true;
-        }
-        value *= 10;
-        value += c - '0';
-    }
-    
+    value = tmp;
     return true;
 }
 
+bool
+Istream::read(
+    uint64_t& value )
+{
+    skipBlanksAndComments();
+    return readNumber( value );
+}
+
 bool
 Istream::read(
     string& value )
 {
     skipBlanks();
     value = "";
-    char c = next();
-    while( !isBlank( c ) )
+    while( current != end || fill() )
     {
+        char c = *current++;
+        if( isBlank( c ) )
+            break;
         value += c;
-        c = next();
     }
     
     return true;
@@ -195,25 +243,31 @@ Istream::getline(
 void
 Istream::skipBlanksAndComments()
 {
-    while( true )
+    while( current != end || fill() )
     {
-        if( buff[ idx ] == '\0' )
-            resetBuffer();
-        switch( buff[ idx ] )
+        switch( *current )
         {
             case ' ':
             case '\t':
             case '\n':
-                next();
+                ++current;
                 break;
 
             case 'c':
-            {
-                char tmp;
-                while( ( tmp = next() ) != '\n' && tmp != '\0' );                
-            }
+                while( true )
+                {
+                    const char* newLine = static_cast< const char* >( memchr( current, '\n', end - current ) );
+                    if( newLine != NULL )
+                    {
+                        current = newLine + 1;
+                        break;
+                    }
+                    current = end;
+                    if( !fill() )
+                        return;
+                }
+                break;
 
-            break;
             default:
                 return;
         }
@@ -223,14 +277,14 @@ Istream::skipBlanksAndComments()
 void
 Istream::skipBlanks()
 {
-    while( true )
+    while( current != end || fill() )
     {
-        switch( buff[ idx ] )
+        switch( *current )
         {
             case ' ':
             case '\t':
             case '\n':
-                next();
+                ++current;
                 break;
 
             default:
@@ -280,4 +334,4 @@ Istream::readInfoDimacs(
     return true;
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,107 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(
+    unsigned int numberOfWorkers ) : currentTask( NULL ), numberOfTasks( 0 ), nextTask( 0 ), pendingTasks( 0 ), activeWorkers( 0 ), batch( 0 ), stop( false )
+{
+    for( unsigned int i = 0; i < numberOfWorkers; i++ )
+        workers.push_back( thread( &ThreadPool::work, this ) );
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard< mutex > guard( lock );
+        stop = true;
+    }
+    wakeUp.notify_all();
+    for( unsigned int i = 0; i < workers.size(); i++ )
+        workers[ i ].join();
+}
+
+void
+ThreadPool::run(
+    unsigned int n,
+    const function< void( unsigned int ) >& task )
+{
+    if( n == 0 )
+        return;
+
+    {
+        unique_lock< mutex > guard( lock );
+        //A worker woken up late may still be looking for tasks of the previous batch.
+        while( activeWorkers > 0 )
+            done.wait( guard );
+        currentTask = &task;
+        numberOfTasks = n;
+        nextTask = 0;
+        pendingTasks = n;
+        batch++;
+    }
+    wakeUp.notify_all();
+
+    executeTasks();
+
+    unique_lock< mutex > guard( lock );
+    while( pendingTasks > 0 || activeWorkers > 0 )
+        done.wait( guard );
+    currentTask = NULL;
+}
+
+void
+ThreadPool::work()
+{
+    unsigned int lastBatch = 0;
+    while( true )
+    {
+        {
+            unique_lock< mutex > guard( lock );
+            while( !stop && lastBatch == batch )
+                wakeUp.wait( guard );
+            if( stop )
+                return;
+            lastBatch = batch;
+            activeWorkers++;
+        }
+
+        executeTasks();
+
+        lock_guard< mutex > guard( lock );
+        if( --activeWorkers == 0 )
+            done.notify_all();
+    }
+}
+
+void
+ThreadPool::executeTasks()
+{
+    while( true )
+    {
+        unsigned int i = nextTask++;
+        if( i >= numberOfTasks )
+            return;
+
+        ( *currentTask )( i );
+
+        lock_guard< mutex > guard( lock );
+        if( --pendingTasks == 0 )
+            done.notify_all();
+    }
+}
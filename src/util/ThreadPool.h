@@ -0,0 +1,65 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/**
+ * A fixed set of worker threads executing batches of independent tasks.
+ * The thread calling run takes part in the computation and returns only
+ * when all the tasks of the batch have been executed.
+ */
+class ThreadPool
+{
+    public:
+        explicit ThreadPool( unsigned int numberOfWorkers );
+        ~ThreadPool();
+
+        void run( unsigned int numberOfTasks, const function< void( unsigned int ) >& task );
+        inline unsigned int numberOfWorkers() const { return workers.size(); }
+
+    private:
+        ThreadPool( const ThreadPool& );
+        ThreadPool& operator=( const ThreadPool& );
+
+        void work();
+        void executeTasks();
+
+        vector< thread > workers;
+        mutex lock;
+        condition_variable wakeUp;
+        condition_variable done;
+
+        const function< void( unsigned int ) >* currentTask;
+        unsigned int numberOfTasks;
+        atomic< unsigned int > nextTask;
+        unsigned int pendingTasks;
+        unsigned int activeWorkers;
+        unsigned int batch;
+        bool stop;
+};
+
+#endif
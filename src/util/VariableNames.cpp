@@ -1,100 +1,158 @@
-/*
- *
- *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
- *
- *  Licensed under the Apache License, Version 2.0 (the "License");
- *  you may not use this file except in compliance with the License.
- *  You may obtain a copy of the License at
- *
- *    http://www.apache.org/licenses/LICENSE-2.0
- *
- *  Unless required by applicable law or agreed to in writing, software
- *  distributed under the License is distributed on an "AS IS" BASIS,
- *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- *  See the License for the specific language governing permissions and
- *  limitations under the License.
- *
- */
-
-#include "VariableNames.h"
-#include "Assert.h"
-vector< string > VariableNames::variables;
-bool VariableNames::toBePrinted = false;
-
-bool
-VariableNames::isHidden(
-    Var v )
-{
-    //assert_msg( v < variables.size(), "Var " << v << " is out of index: " << variables.size() );
-    if( v >= variables.size() )
-        return true;
-    return variables[ v ] == "";
-}
-
-const string&
-VariableNames::getName(
-    Var v )
-{
-    #ifdef TRACE_ON
-    if( isHidden( v ) )
-    {
-        stringstream s;
-        s << v;
-        variables[ v ] = s.str();
-    }
-    #endif
-    assert( !isHidden( v ) );
-    return variables[ v ];
-}
-
-bool
-VariableNames::getVariable (
-	const string& name,
-	Var& v )
-{
-	for ( unsigned int i = 0; i < variables.size(); i++ )
-	{
-		if ( variables[i].compare( name ) == 0 )
-		{
-			v = i;
-			return true;
-		}
-	}
-
-	return false;
-}
-
-const vector< string >&
-VariableNames::getVariableNames()
-{
-    return variables;
-}
-
-void
-VariableNames::setName(
-    Var v,
-    string name )
-{
-    assert_msg( v < variables.size(), "Access element " << v << " in a vector of size " << variables.size() << "." );
-    variables[ v ] = name;
-}
-
-void
-VariableNames::addVariable()
-{
-    variables.push_back( "" );
-}
-
-void
-VariableNames::setToBePrinted(
-    Var v )
-{
-    variables[ v ] = "1";
-}
-
-bool
-VariableNames::hasToBePrinted(
-    Var v )
-{
-    return variables[ v ] == "1";
-}
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "VariableNames.h"
+#include "Assert.h"
+
+#include <cstring>
+#include <sstream>
+
+string VariableNames::names;
+vector< unsigned int > VariableNames::offsets;
+Var VariableNames::lastNamedVariable = 0;
+bool VariableNames::unparsed = false;
+unsigned int VariableNames::toBePrinted = 0;
+
+const char*
+VariableNames::getHiddenName(
+    Var v )
+{
+    stringstream s;
+    s << v;
+    setName( v, s.str() );
+    return names.data() + offsets[ v ];
+}
+
+bool
+VariableNames::getVariable (
+    const string& name,
+    Var& v )
+{
+    for( unsigned int i = 0; i < offsets.size(); i++ )
+    {
+        if( !isHidden( i ) && strcmp( getName( i ), name.c_str() ) == 0 )
+        {
+            v = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+vector< string >
+VariableNames::getVariableNames()
+{
+    vector< string > variables( offsets.size() );
+    for( unsigned int i = 0; i < offsets.size(); i++ )
+        if( !isHidden( i ) )
+            variables[ i ] = getName( i );
+    return variables;
+}
+
+void
+VariableNames::setName(
+    Var v,
+    const char* name )
+{
+    assert_msg( v < offsets.size(), "Access element " << v << " in a vector of size " << offsets.size() << "." );
+    if( unparsed )
+        parseNames();
+    if( *name == '\0' )
+    {
+        offsets[ v ] = 0;
+        return;
+    }
+
+    //Offset 0 is reserved for hidden variables.
+    if( names.empty() )
+        names.push_back( '\0' );
+    offsets[ v ] = names.size();
+    names.append( name );
+    names.push_back( '\0' );
+}
+
+void
+VariableNames::setUnparsedNames(
+    string& symbolTable,
+    Var lastNamed )
+{
+    assert( names.empty() );
+    names.swap( symbolTable );
+    lastNamedVariable = lastNamed;
+    unparsed = true;
+}
+
+void
+VariableNames::parseNames()
+{
+    unparsed = false;
+
+    //Each line "id name" is replaced in place: the name is null-terminated and its offset is stored.
+    //Names never start at offset 0 since each line starts with an id.
+    char* line = &names[ 0 ];
+    char* end = line + names.size();
+    while( line < end )
+    {
+        char* newLine = static_cast< char* >( memchr( line, '\n', end - line ) );
+        if( newLine == NULL )
+            newLine = end;
+
+        while( line < newLine && ( *line == ' ' || *line == '\t' ) )
+            ++line;
+        Var id = 0;
+        while( line < newLine && '0' <= *line && *line <= '9' )
+            id = id * 10 + ( *line++ - '0' );
+        //The delimiter after the id is skipped, as done by Istream.
+        if( line < newLine )
+            ++line;
+
+        if( id != 0 && id <= lastNamedVariable && id < offsets.size() && line < newLine )
+            offsets[ id ] = line - names.data();
+
+        if( newLine == end )
+        {
+            names.push_back( '\0' );
+            break;
+        }
+        *newLine = '\0';
+        line = newLine + 1;
+    }
+}
+
+void
+VariableNames::setToBePrinted(
+    Var v )
+{
+    if( toBePrinted == 0 )
+    {
+        setName( v, "1" );
+        toBePrinted = offsets[ v ];
+    }
+    else
+    {
+        offsets[ v ] = toBePrinted;
+    }
+}
+
+bool
+VariableNames::hasToBePrinted(
+    Var v )
+{
+    return !isHidden( v ) && strcmp( getName( v ), "1" ) == 0;
+}
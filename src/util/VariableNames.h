@@ -1,46 +1,87 @@
-/*
- *
- *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
- *
- *  Licensed under the Apache License, Version 2.0 (the "License");
- *  you may not use this file except in compliance with the License.
- *  You may obtain a copy of the License at
- *
- *    http://www.apache.org/licenses/LICENSE-2.0
- *
- *  Unless required by applicable law or agreed to in writing, software
- *  distributed under the License is distributed on an "AS IS" BASIS,
- *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- *  See the License for the specific language governing permissions and
- *  limitations under the License.
- *
- */
-
-#ifndef VARIABLENAMES_H
-#define VARIABLENAMES_H
-
-#include <cassert>
-#include <iostream>
-#include <vector>
-#include "Constants.h"
-using namespace std;
-
-class VariableNames
-{
-    public:
-
-        static bool isHidden( Var v );
-        static const string& getName( Var v );
-        static bool getVariable ( const string& name, Var& v );
-        static void setName( Var v, string name );
-        static void setToBePrinted( Var v );
-        static bool hasToBePrinted( Var v );
-        static void addVariable();
-        static const vector< string >& getVariableNames();
-        
-    private:        
-        static vector< string > variables;
-        static bool toBePrinted;
-};
-
-#endif
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#ifndef VARIABLENAMES_H
+#define VARIABLENAMES_H
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Constants.h"
+using namespace std;
+
+/**
+ * Names are stored null-terminated in a single arena and each variable keeps
+ * only the offset of its name: hidden variables cost one unsigned int.
+ * The symbol table of the input can also be stored un-parsed, in which case
+ * it becomes the arena the first time a name is requested.
+ */
+class VariableNames
+{
+    public:
+
+        static inline bool isHidden( Var v );
+        static inline const char* getName( Var v );
+        static bool getVariable ( const string& name, Var& v );
+        static void setName( Var v, const char* name );
+        static void setName( Var v, const string& name ) { setName( v, name.c_str() ); }
+        static void setToBePrinted( Var v );
+        static bool hasToBePrinted( Var v );
+        static void addVariable() { offsets.push_back( 0 ); }
+        static vector< string > getVariableNames();
+
+        /**
+         * Takes the lines "id name" of a symbol table, which are parsed on demand.
+         * Ids greater than lastNamedVariable are ignored.
+         */
+        static void setUnparsedNames( string& symbolTable, Var lastNamedVariable );
+
+    private:
+        static void parseNames();
+        static const char* getHiddenName( Var v );
+
+        static string names;
+        static vector< unsigned int > offsets;
+        static Var lastNamedVariable;
+        static bool unparsed;
+        static unsigned int toBePrinted;
+};
+
+bool
+VariableNames::isHidden(
+    Var v )
+{
+    if( unparsed )
+        parseNames();
+    return v >= offsets.size() || offsets[ v ] == 0;
+}
+
+const char*
+VariableNames::getName(
+    Var v )
+{
+    #ifdef TRACE_ON
+    if( isHidden( v ) )
+        return getHiddenName( v );
+    #endif
+    assert( !isHidden( v ) );
+    return names.data() + offsets[ v ];
+}
+
+#endif
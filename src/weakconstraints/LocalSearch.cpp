@@ -0,0 +1,314 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+#include "LocalSearch.h"
+#include "../Solver.h"
+
+#define LOCAL_SEARCH_NOISE 10
+#define LOCAL_SEARCH_SAMPLE 8
+
+LocalSearch::LocalSearch(
+    Solver& s ) : solver( s ), numberOfVariables( s.numberOfVariables() ), cost( 0 ), seed( 91648253 )
+{
+    begins.push_back( 0 );
+    occurrences.resize( 2 * numberOfVariables + 2 );
+    vector< Literal > lits;
+    vector< uint64_t > ws;
+    for( Solver::ClauseIterator it = solver.clauses_begin(); it != solver.clauses_end(); ++it )
+    {
+        const Clause& clause = **it;
+        lits.clear();
+        for( unsigned int i = 0; i < clause.size(); i++ )
+            lits.push_back( clause[ i ] );
+        ws.assign( lits.size(), 1 );
+        addConstraint( lits, ws, 1 );
+    }
+
+    for( Var v = 1; v <= numberOfVariables; v++ )
+    {
+        Literal pos( v, POSITIVE );
+        for( unsigned int j = 0; j < 2; j++ )
+        {
+            Literal lit = j == 0 ? pos : pos.getOppositeLiteral();
+            const Vector< Literal >& binaryClauses = solver.getBinaryClauses( lit );
+            for( unsigned int i = 0; i < binaryClauses.size(); i++ )
+            {
+                //Each binary clause is stored for both its literals.
+                if( lit.getIndex() > binaryClauses[ i ].getIndex() )
+                    continue;
+                lits.clear();
+                lits.push_back( lit );
+                lits.push_back( binaryClauses[ i ] );
+                ws.assign( 2, 1 );
+                addConstraint( lits, ws, 1 );
+            }
+        }
+    }
+
+    //An aggregate a <-> sum >= bound is split in a -> sum >= bound and ~a -> sum < bound.
+    for( unsigned int i = 0; i < solver.numberOfAggregates(); i++ )
+    {
+        const Aggregate& aggregate = solver.getAggregate( i );
+        Literal aggregateLiteral = aggregate.getLiteral( 1 ).getOppositeLiteral();
+        uint64_t bound = aggregate.getBound();
+        uint64_t sum = 0;
+        for( unsigned int j = 2; j <= aggregate.size(); j++ )
+            sum += aggregate.getWeight( j );
+
+        lits.clear();
+        ws.clear();
+        lits.push_back( aggregateLiteral.getOppositeLiteral() );
+        ws.push_back( bound );
+        for( unsigned int j = 2; j <= aggregate.size(); j++ )
+        {
+            lits.push_back( aggregate.getLiteral( j ) );
+            ws.push_back( aggregate.getWeight( j ) );
+        }
+        addConstraint( lits, ws, bound );
+
+        if( sum < bound )
+            continue;
+        for( unsigned int j = 0; j < lits.size(); j++ )
+            lits[ j ] = lits[ j ].getOppositeLiteral();
+        ws[ 0 ] = sum - bound + 1;
+        addConstraint( lits, ws, sum - bound + 1 );
+    }
+
+    value.resize( numberOfVariables + 1, false );
+    fixed.resize( numberOfVariables + 1, true );
+    costIfTrue.resize( numberOfVariables + 1, 0 );
+    costIfFalse.resize( numberOfVariables + 1, 0 );
+    positionInCostly.resize( numberOfVariables + 1, UINT_MAX );
+    trace_msg( weakconstraints, 1, "Local search on " << degrees.size() << " constraints and " << numberOfVariables << " variables" );
+}
+
+void
+LocalSearch::addConstraint(
+    const vector< Literal >& lits,
+    const vector< uint64_t >& ws,
+    uint64_t degree )
+{
+    assert( lits.size() == ws.size() );
+    unsigned int id = degrees.size();
+    for( unsigned int i = 0; i < lits.size(); i++ )
+    {
+        if( lits[ i ].getVariable() > numberOfVariables )
+            continue;
+        occurrences[ lits[ i ].getIndex() ].push_back( literals.size() );
+        literals.push_back( lits[ i ] );
+        weights.push_back( ws[ i ] );
+        constraintOf.push_back( id );
+    }
+    begins.push_back( literals.size() );
+    degrees.push_back( degree );
+    sumOfTrueLiterals.push_back( 0 );
+    constraintWeights.push_back( 1 );
+    positionInUnsat.push_back( UINT_MAX );
+}
+
+void
+LocalSearch::initAssignment(
+    unsigned int level )
+{
+    cost = 0;
+    costlyVariables.clear();
+    unsatConstraints.clear();
+    for( Var v = 1; v <= numberOfVariables; v++ )
+    {
+        costIfTrue[ v ] = costIfFalse[ v ] = 0;
+        positionInCostly[ v ] = UINT_MAX;
+    }
+
+    //Aux literals are relaxations added by core-guided algorithms: they are not part of the cost.
+    for( unsigned int i = 0; i < solver.numberOfOptimizationLiterals( level ); i++ )
+    {
+        OptimizationLiteralData& optLitData = solver.getOptimizationLiteral( level, i );
+        Var v = optLitData.lit.getVariable();
+        if( optLitData.isAux() || v > numberOfVariables )
+            continue;
+        if( optLitData.lit.isPositive() )
+            costIfTrue[ v ] += optLitData.weight;
+        else
+            costIfFalse[ v ] += optLitData.weight;
+    }
+
+    //Undefined variables start from the phase of the solver.
+    for( Var v = 1; v <= numberOfVariables; v++ )
+    {
+        fixed[ v ] = !solver.isUndefined( v ) || solver.hasBeenEliminated( v );
+        value[ v ] = solver.isUndefined( v ) ? solver.getCachedTruthValue( v ) == TRUE : solver.isTrue( v );
+        cost += value[ v ] ? costIfTrue[ v ] : costIfFalse[ v ];
+        if( !fixed[ v ] )
+            updateCostly( v );
+    }
+
+    for( unsigned int c = 0; c < degrees.size(); c++ )
+    {
+        constraintWeights[ c ] = 1;
+        positionInUnsat[ c ] = UINT_MAX;
+        sumOfTrueLiterals[ c ] = 0;
+        for( unsigned int i = begins[ c ]; i < begins[ c + 1 ]; i++ )
+            if( isTrue( literals[ i ] ) )
+                sumOfTrueLiterals[ c ] += weights[ i ];
+        if( !isSatisfied( c ) )
+            setUnsat( c );
+    }
+}
+
+bool
+LocalSearch::run(
+    unsigned int level,
+    unsigned int maxFlips )
+{
+    initAssignment( level );
+    uint64_t bestCost = UINT64_MAX;
+    for( unsigned int flips = 0; flips < maxFlips; flips++ )
+    {
+        if( unsatConstraints.empty() )
+        {
+            if( cost < bestCost )
+            {
+                trace_msg( weakconstraints, 2, "Local search: assignment with cost " << cost << " after " << flips << " flips" );
+                bestCost = cost;
+                bestValue = value;
+            }
+            if( costlyVariables.empty() )
+                break;
+
+            //All constraints are satisfied: pay less, possibly violating some constraints.
+            Var best = 0;
+            int64_t bestScore = INT64_MIN;
+            for( unsigned int i = 0; i < LOCAL_SEARCH_SAMPLE; i++ )
+            {
+                Var v = costlyVariables[ random( costlyVariables.size() ) ];
+                int64_t s = score( v );
+                if( s > bestScore )
+                {
+                    bestScore = s;
+                    best = v;
+                }
+            }
+            flip( best );
+            continue;
+        }
+
+        unsigned int c = unsatConstraints[ random( unsatConstraints.size() ) ];
+        Var best = 0;
+        int64_t bestScore = INT64_MIN;
+        for( unsigned int i = begins[ c ]; i < begins[ c + 1 ]; i++ )
+        {
+            Var v = literals[ i ].getVariable();
+            if( fixed[ v ] || isTrue( literals[ i ] ) )
+                continue;
+            int64_t s = score( v );
+            if( s > bestScore )
+            {
+                bestScore = s;
+                best = v;
+            }
+        }
+        if( best == 0 )
+            break;
+
+        if( bestScore <= 0 )
+        {
+            //Local minimum: violated constraints become heavier.
+            for( unsigned int i = 0; i < unsatConstraints.size(); i++ )
+                constraintWeights[ unsatConstraints[ i ] ]++;
+            if( random( 100 ) < LOCAL_SEARCH_NOISE )
+            {
+                unsigned int i = begins[ c ] + random( begins[ c + 1 ] - begins[ c ] );
+                if( !fixed[ literals[ i ].getVariable() ] && !isTrue( literals[ i ] ) )
+                    best = literals[ i ].getVariable();
+            }
+        }
+        flip( best );
+    }
+
+    if( bestCost == UINT64_MAX )
+        return false;
+
+    for( Var v = 1; v <= numberOfVariables; v++ )
+        if( !fixed[ v ] )
+            solver.setCachedTruthValue( v, bestValue[ v ] ? TRUE : FALSE );
+    return true;
+}
+
+int64_t
+LocalSearch::score(
+    Var v ) const
+{
+    //Decrease of the weighted amount missing to satisfy the constraints.
+    Literal trueLiteral( v, value[ v ] ? POSITIVE : NEGATIVE );
+    int64_t s = 0;
+    const vector< unsigned int >& becomingFalse = occurrences[ trueLiteral.getIndex() ];
+    for( unsigned int i = 0; i < becomingFalse.size(); i++ )
+    {
+        unsigned int c = constraintOf[ becomingFalse[ i ] ];
+        uint64_t sum = sumOfTrueLiterals[ c ];
+        s -= constraintWeights[ c ] * ( int64_t ) ( missing( c, sum - weights[ becomingFalse[ i ] ] ) - missing( c, sum ) );
+    }
+
+    const vector< unsigned int >& becomingTrue = occurrences[ trueLiteral.getOppositeLiteral().getIndex() ];
+    for( unsigned int i = 0; i < becomingTrue.size(); i++ )
+    {
+        unsigned int c = constraintOf[ becomingTrue[ i ] ];
+        uint64_t sum = sumOfTrueLiterals[ c ];
+        s += constraintWeights[ c ] * ( int64_t ) ( missing( c, sum ) - missing( c, sum + weights[ becomingTrue[ i ] ] ) );
+    }
+
+    uint64_t current = value[ v ] ? costIfTrue[ v ] : costIfFalse[ v ];
+    uint64_t next = value[ v ] ? costIfFalse[ v ] : costIfTrue[ v ];
+    if( next < current )
+        s++;
+    else if( next > current )
+        s--;
+    return s;
+}
+
+void
+LocalSearch::flip(
+    Var v )
+{
+    assert( v > 0 && v <= numberOfVariables && !fixed[ v ] );
+    Literal trueLiteral( v, value[ v ] ? POSITIVE : NEGATIVE );
+    cost -= value[ v ] ? costIfTrue[ v ] : costIfFalse[ v ];
+    value[ v ] = !value[ v ];
+    cost += value[ v ] ? costIfTrue[ v ] : costIfFalse[ v ];
+
+    const vector< unsigned int >& becomingFalse = occurrences[ trueLiteral.getIndex() ];
+    for( unsigned int i = 0; i < becomingFalse.size(); i++ )
+    {
+        unsigned int c = constraintOf[ becomingFalse[ i ] ];
+        bool wasSatisfied = isSatisfied( c );
+        sumOfTrueLiterals[ c ] -= weights[ becomingFalse[ i ] ];
+        if( wasSatisfied && !isSatisfied( c ) )
+            setUnsat( c );
+    }
+
+    const vector< unsigned int >& becomingTrue = occurrences[ trueLiteral.getOppositeLiteral().getIndex() ];
+    for( unsigned int i = 0; i < becomingTrue.size(); i++ )
+    {
+        unsigned int c = constraintOf[ becomingTrue[ i ] ];
+        bool wasSatisfied = isSatisfied( c );
+        sumOfTrueLiterals[ c ] += weights[ becomingTrue[ i ] ];
+        if( !wasSatisfied && isSatisfied( c ) )
+            setSat( c );
+    }
+
+    updateCostly( v );
+}
@@ -0,0 +1,134 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+
+#include <vector>
+using namespace std;
+#include "../Literal.h"
+#include "../util/Constants.h"
+
+class Solver;
+
+/*
+ * Local search with dynamic constraint weights over the clauses and the
+ * aggregates of the solver and the optimization literals of one level.
+ * Unfounded sets and other propagators are not considered: the best
+ * assignment is only used as the phase of the solver, which repairs it into
+ * an answer set.
+ */
+class LocalSearch
+{
+    public:
+        LocalSearch( Solver& s );
+
+        bool run( unsigned int level, unsigned int maxFlips );
+
+    private:
+        Solver& solver;
+        unsigned int numberOfVariables;
+
+        //Each constraint requires a sum of weights of true literals of at least its degree.
+        vector< Literal > literals;
+        vector< uint64_t > weights;
+        vector< unsigned int > constraintOf;
+        vector< unsigned int > begins;
+        vector< uint64_t > degrees;
+        vector< uint64_t > sumOfTrueLiterals;
+        vector< unsigned int > constraintWeights;
+        vector< unsigned int > unsatConstraints;
+        vector< unsigned int > positionInUnsat;
+        vector< vector< unsigned int > > occurrences;
+
+        vector< bool > value;
+        vector< bool > bestValue;
+        vector< bool > fixed;
+        vector< uint64_t > costIfTrue;
+        vector< uint64_t > costIfFalse;
+        vector< Var > costlyVariables;
+        vector< unsigned int > positionInCostly;
+        uint64_t cost;
+
+        double seed;
+
+        void addConstraint( const vector< Literal >& lits, const vector< uint64_t >& ws, uint64_t degree );
+        inline bool isTrue( Literal lit ) const { return value[ lit.getVariable() ] == lit.isPositive(); }
+        inline bool isSatisfied( unsigned int c ) const { return sumOfTrueLiterals[ c ] >= degrees[ c ]; }
+        inline uint64_t missing( unsigned int c, uint64_t sum ) const { return sum >= degrees[ c ] ? 0 : degrees[ c ] - sum; }
+        inline bool isCostly( Var v ) const { return value[ v ] ? costIfTrue[ v ] > 0 : costIfFalse[ v ] > 0; }
+        inline void setSat( unsigned int c );
+        inline void setUnsat( unsigned int c );
+        inline void updateCostly( Var v );
+        int64_t score( Var v ) const;
+        void flip( Var v );
+        void initAssignment( unsigned int level );
+        inline unsigned int random( unsigned int size );
+};
+
+void
+LocalSearch::setSat(
+    unsigned int c )
+{
+    assert( positionInUnsat[ c ] < unsatConstraints.size() );
+    unsigned int last = unsatConstraints.back();
+    unsatConstraints[ positionInUnsat[ c ] ] = last;
+    positionInUnsat[ last ] = positionInUnsat[ c ];
+    unsatConstraints.pop_back();
+    positionInUnsat[ c ] = UINT_MAX;
+}
+
+void
+LocalSearch::setUnsat(
+    unsigned int c )
+{
+    assert( positionInUnsat[ c ] == UINT_MAX );
+    positionInUnsat[ c ] = unsatConstraints.size();
+    unsatConstraints.push_back( c );
+}
+void
+LocalSearch::updateCostly(
+    Var v )
+{
+    bool costly = isCostly( v );
+    if( costly && positionInCostly[ v ] == UINT_MAX )
+    {
+        positionInCostly[ v ] = costlyVariables.size();
+        costlyVariables.push_back( v );
+    }
+    else if( !costly && positionInCostly[ v ] != UINT_MAX )
+    {
+        Var last = costlyVariables.back();
+        costlyVariables[ positionInCostly[ v ] ] = last;
+        positionInCostly[ last ] = positionInCostly[ v ];
+        costlyVariables.pop_back();
+        positionInCostly[ v ] = UINT_MAX;
+    }
+}
+
+// Returns a random integer 0 <= x < size. Seed must never be 0.
+unsigned int
+LocalSearch::random(
+    unsigned int size )
+{
+    seed *= 1389796;
+    int q = ( int )( seed / 2147483647 );
+    seed -= ( double )q * 2147483647;
+    return ( unsigned int )( seed / 2147483647 * size );
+}
+
+#endif
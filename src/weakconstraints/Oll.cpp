@@ -22,6 +22,8 @@ Oll::~Oll()
 {
     for( unsigned int i = 0; i < elements.size(); i++ )
         delete elements[ i ];
+    for( unsigned int i = 0; i < totalizers.size(); i++ )
+        delete totalizers[ i ];
 }
 
 unsigned int
@@ -51,6 +53,7 @@ Oll::runUnweighted()
     {        
         if( !foundUnsat() )
             return INCOHERENT;
+        runLocalSearchPeriodically();
         assumptions.clear();
         computeAssumptions();        
     }
@@ -96,6 +99,7 @@ Oll::runWeighted()
         {
             if( !foundUnsat() )
                 return INCOHERENT;
+            runLocalSearchPeriodically();
             assumptions.clear();
             computeAssumptionsStratified();
         }
@@ -324,6 +328,8 @@ Oll::foundUnsat()
     vector< unsigned int > auxVariablesInUnsatCore;
     ++numberOfCalls;
     assert( solver.getUnsatCore() != NULL );
+    if( wasp::Options::trimCore )
+        trimCore();
     const Clause& unsatCore = *( solver.getUnsatCore() );
     
     //The incoherence does not depend on weak constraints
@@ -341,11 +347,14 @@ Oll::foundUnsat()
             auxVariablesInUnsatCore.push_back( v );
     }
 
+    uint64_t minWeight = computeMinWeight();
+    if( wasp::Options::totalizer )
+        return processCoreTotalizer( minWeight );
+
     vector< Literal > literals;
     vector< uint64_t > weights;
 
     unsigned int n = 0;
-    uint64_t minWeight = computeMinWeight();
     if( !processCoreOll( literals, weights, minWeight, n ) )
         return false;
     incrementLb( minWeight );
@@ -353,6 +362,16 @@ Oll::foundUnsat()
     if( !addAggregateOll( literals, weights, n + 1, minWeight ) )
         return false;        
 
+    //Bound j is assumed by the auxiliary variable in position 2n-1-j: when it is unsat such a variable is false.
+    for( unsigned int j = 1; wasp::Options::exhaustCore && j < n; j++ )
+    {
+        bool exhausted;
+        if( !exhaustBound( literals[ 2 * n - 1 - j ], exhausted ) )
+            return false;
+        if( !exhausted )
+            break;
+    }
+
 //    for( unsigned int i = 0; i < auxVariablesInUnsatCore.size(); i++ )
 //    {
 //        Var guardId = auxVariablesInUnsatCore[ i ];
@@ -373,3 +392,77 @@ Oll::foundUnsat()
     
     return true;
 }
+
+bool
+Oll::processCoreTotalizer(
+    uint64_t minWeight )
+{
+    vector< Literal > literals;
+    vector< uint64_t > weights;
+    if( !processCoreOll( literals, weights, minWeight ) )
+        return false;
+    incrementLb( minWeight );
+    solver.foundLowerBound( lb() );
+
+    //At most one literal of the core can be true for free, the second one costs minWeight.
+    if( literals.size() > 1 )
+    {
+        trace_msg( weakconstraints, 2, "Adding totalizer from unsat core of size " << literals.size() );
+        Totalizer* totalizer = new Totalizer( *this, literals );
+        totalizers.push_back( totalizer );
+        if( !addTotalizerOutput( totalizer, 2, minWeight ) )
+            return false;
+
+        for( unsigned int bound = 2; wasp::Options::exhaustCore; bound++ )
+        {
+            bool exhausted;
+            if( !exhaustBound( totalizer->getOutput( bound ).getOppositeLiteral(), exhausted ) )
+                return false;
+            if( !exhausted || bound == totalizer->numberOfInputs() )
+                break;
+            if( !addTotalizerOutput( totalizer, bound + 1, minWeight ) )
+                return false;
+        }
+    }
+
+    //Outputs of previous totalizers in the core: the next output of the same totalizer becomes relevant.
+    for( unsigned int i = 0; i < literals.size(); i++ )
+    {
+        unordered_map< Var, pair< Totalizer*, unsigned int > >::iterator it = totalizerOutputs.find( literals[ i ].getVariable() );
+        if( it == totalizerOutputs.end() )
+            continue;
+
+        Totalizer* totalizer = it->second.first;
+        unsigned int bound = it->second.second + 1;
+        if( bound <= totalizer->numberOfInputs() && !addTotalizerOutput( totalizer, bound, minWeight ) )
+            return false;
+    }
+
+    return true;
+}
+
+bool
+Oll::addTotalizerOutput(
+    Totalizer* totalizer,
+    unsigned int bound,
+    uint64_t weight )
+{
+    if( !totalizer->extend( bound ) )
+        return false;
+
+    Literal output = totalizer->getOutput( bound );
+    trace_msg( weakconstraints, 3, "Adding output " << output << " for bound " << bound << " with weight " << weight );
+    totalizerOutputs[ output.getVariable() ] = pair< Totalizer*, unsigned int >( totalizer, bound );
+
+    //The output may be still an assumption if a residual weight was left by a previous core.
+    for( unsigned int i = 0; i < solver.numberOfOptimizationLiterals( level() ); i++ )
+    {
+        OptimizationLiteralData& optLitData = solver.getOptimizationLiteral( level(), i );
+        if( optLitData.isRemoved() || optLitData.lit != output )
+            continue;
+        weight += optLitData.weight;
+        optLitData.remove();
+    }
+    solver.addOptimizationLiteral( output, weight, level(), true );
+    return true;
+}
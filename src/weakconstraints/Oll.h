@@ -20,6 +20,7 @@
 #define OLL_H
 
 #include "WeakInterface.h"
+#include "Totalizer.h"
 #include <unordered_map>
 using namespace std;
 
@@ -59,12 +60,16 @@ class Oll : public WeakInterface
         inline bool hasOllData( Var v ) const;
         inline OllData* getOllData( Var v );
         inline void setOllData( Var v, OllData* );
+        bool processCoreTotalizer( uint64_t minWeight );
+        bool addTotalizerOutput( Totalizer* totalizer, unsigned int bound, uint64_t weight );
         
         bool foundUnsat();
         unsigned int originalNumberOfVariables;
 
     private:
         unordered_map< Var, OllData* > elements;                
+        vector< Totalizer* > totalizers;
+        unordered_map< Var, pair< Totalizer*, unsigned int > > totalizerOutputs;
 };
 
 //Var
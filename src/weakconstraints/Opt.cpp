@@ -29,11 +29,24 @@ Opt::run()
     if( !disableprefchoices_ )
         solver.addPreferredChoicesFromOptimizationLiterals( level() );
     unsigned int numberOfModels = 0;
-    while( solver.solve( assumptions ) == COHERENT )
+    neighbourhoodAttempts = 0;
+    while( true )
     {
+        //Neighbourhoods of the best model are explored first: only the full search can prove optimality.
+        bool restricted = computeNeighbourhood();
+        unsigned int result = restricted ? solveNeighbourhood() : solver.solve( assumptions );
+        if( result != COHERENT )
+        {
+            if( !restricted )
+                break;
+            resetSolver();
+            continue;
+        }
+
         numberOfModels++;
         uint64_t modelCost = solver.computeCostOfModel( level() );
         foundAnswerSet( modelCost );        
+        saveBestModel();
 //        solver.printOptimizationValue( modelCost );
         trace_msg( weakconstraints, 2, "Decision level of solver: " << solver.getCurrentDecisionLevel() );
         if( modelCost == 0 || solver.getCurrentDecisionLevel() == 0 )
@@ -110,6 +123,54 @@ Opt::updateOptimizationAggregate(
     return true;
 }
 
+void
+Opt::saveBestModel()
+{
+    if( wasp::Options::solutionGuided )
+        solver.saveSolutionPhases();
+
+    if( wasp::Options::lns == 0 )
+        return;
+    bestModel.clear();
+    for( Var v = 1; v <= solver.numberOfVariables(); v++ )
+    {
+        if( solver.hasBeenEliminated( v ) || solver.getDecisionLevel( v ) == 0 )
+            continue;
+        bestModel.push_back( Literal( v, solver.isTrue( v ) ? POSITIVE : NEGATIVE ) );
+    }
+    neighbourhoodAttempts = 0;
+}
+
+bool
+Opt::computeNeighbourhood()
+{
+    if( bestModel.empty() )
+        return false;
+
+    //The fixed part is a window rotating over the best model: after enough attempts every variable has been free once.
+    unsigned int size = bestModel.size();
+    unsigned int fixed = ( uint64_t ) size * wasp::Options::lns / 100;
+    if( fixed == size || ( uint64_t ) neighbourhoodAttempts * ( size - fixed ) >= size )
+        return false;
+
+    neighbourhood.assign( assumptions.begin(), assumptions.end() );
+    for( unsigned int i = 0; i < fixed; i++ )
+        neighbourhood.push_back( bestModel[ ( neighbourhoodStart + i ) % size ] );
+    neighbourhoodStart = ( neighbourhoodStart + size - fixed ) % size;
+    neighbourhoodAttempts++;
+    trace_msg( weakconstraints, 2, "Exploring neighbourhood " << neighbourhoodAttempts << ": " << fixed << " of " << size << " variables fixed" );
+    return true;
+}
+
+unsigned int
+Opt::solveNeighbourhood()
+{
+    solver.setMaxNumberOfConflicts( solver.getNumberOfConflicts() + wasp::Options::coreBudget );
+    unsigned int result = solver.solve( neighbourhood );
+    solver.setMaxNumberOfConflicts( UINT64_MAX );
+    return result;
+}
+
 bool
 Opt::completedLevel()
 {
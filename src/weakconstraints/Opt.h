@@ -24,7 +24,7 @@
 class Opt : public WeakInterface
 {
     public:
-        Opt( Solver& s, bool disable = false ) : WeakInterface( s ), disableprefchoices_( disable ), aggregate( NULL ), varId( 0 ) {}
+        Opt( Solver& s, bool disable = false ) : WeakInterface( s ), disableprefchoices_( disable ), aggregate( NULL ), varId( 0 ), neighbourhoodStart( 0 ), neighbourhoodAttempts( 0 ) {}
         unsigned int run();
         bool updateOptimizationAggregate( uint64_t modelCost );
         bool completedLevel();
@@ -34,7 +34,14 @@ class Opt : public WeakInterface
         bool disableprefchoices_;
         Aggregate* aggregate;
         Var varId;
+        vector< Literal > bestModel;
+        vector< Literal > neighbourhood;
+        unsigned int neighbourhoodStart;
+        unsigned int neighbourhoodAttempts;
         void createOptimizationAggregate( uint64_t modelCost );        
+        void saveBestModel();
+        bool computeNeighbourhood();
+        unsigned int solveNeighbourhood();
 };
 
 #endif
\ No newline at end of file
@@ -41,6 +41,7 @@ PMRes::runUnweighted()
     {        
         if( !foundUnsat() )
             return INCOHERENT;
+        runLocalSearchPeriodically();
         assumptions.clear();
         computeAssumptions();
     }
@@ -83,6 +84,7 @@ PMRes::runWeighted()
         {
             if( !foundUnsat() )
                 return INCOHERENT;
+            runLocalSearchPeriodically();
             assumptions.clear();
             computeAssumptionsStratified();
         }
@@ -151,6 +153,8 @@ PMRes::foundUnsat()
 {
     ++numberOfCalls;
     assert( solver.getUnsatCore() != NULL );
+    if( wasp::Options::trimCore )
+        trimCore();
     const Clause& unsatCore = *( solver.getUnsatCore() );
 
     //The incoherence does not depend on weak constraints
@@ -0,0 +1,120 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+#include "Totalizer.h"
+#include "WeakInterface.h"
+
+Totalizer::Totalizer(
+    WeakInterface& w,
+    const vector< Literal >& inputs ) : weakInterface( w )
+{
+    assert( !inputs.empty() );
+    root = createNode( inputs, 0, inputs.size() );
+}
+
+unsigned int
+Totalizer::createNode(
+    const vector< Literal >& inputs,
+    unsigned int begin,
+    unsigned int end )
+{
+    assert( begin < end );
+    if( end - begin == 1 )
+    {
+        nodes.push_back( Node( 0, 0, 1 ) );
+        nodes.back().outputs.push_back( inputs[ begin ] );
+        return nodes.size() - 1;
+    }
+
+    unsigned int middle = begin + ( end - begin ) / 2;
+    unsigned int left = createNode( inputs, begin, middle );
+    unsigned int right = createNode( inputs, middle, end );
+    nodes.push_back( Node( left, right, end - begin ) );
+    return nodes.size() - 1;
+}
+
+bool
+Totalizer::extend(
+    unsigned int bound )
+{
+    trace_msg( weakconstraints, 3, "Extending totalizer to bound " << bound );
+    return extendNode( root, bound );
+}
+
+bool
+Totalizer::extendNode(
+    unsigned int node,
+    unsigned int bound )
+{
+    unsigned int newSize = min( bound, nodes[ node ].leaves );
+    unsigned int oldSize = nodes[ node ].outputs.size();
+    if( oldSize >= newSize )
+        return true;
+
+    unsigned int left = nodes[ node ].left;
+    unsigned int right = nodes[ node ].right;
+    if( !extendNode( left, bound ) || !extendNode( right, bound ) )
+        return false;
+
+    for( unsigned int k = oldSize + 1; k <= newSize; k++ )
+        nodes[ node ].outputs.push_back( Literal( weakInterface.addAuxVariable(), POSITIVE ) );
+
+    //Only outputs created now are implied: older outputs are not affected by new outputs of children.
+    const vector< Literal >& leftOutputs = nodes[ left ].outputs;
+    const vector< Literal >& rightOutputs = nodes[ right ].outputs;
+    for( unsigned int k = oldSize + 1; k <= newSize; k++ )
+    {
+        for( unsigned int i = 0; i <= leftOutputs.size() && i <= k; i++ )
+        {
+            unsigned int j = k - i;
+            if( j > rightOutputs.size() )
+                continue;
+
+            Clause* clause = new Clause();
+            if( i > 0 )
+                clause->addLiteral( leftOutputs[ i - 1 ].getOppositeLiteral() );
+            if( j > 0 )
+                clause->addLiteral( rightOutputs[ j - 1 ].getOppositeLiteral() );
+            clause->addLiteral( nodes[ node ].outputs[ k - 1 ] );
+            if( !addClause( clause ) )
+                return false;
+        }
+    }
+    return true;
+}
+
+bool
+Totalizer::addClause(
+    Clause* clause )
+{
+    //Inputs may be assigned at level 0.
+    Solver& solver = weakInterface.solver;
+    unsigned int j = 0;
+    for( unsigned int i = 0; i < clause->size(); i++ )
+    {
+        Literal lit = clause->getAt( i );
+        if( solver.isTrue( lit ) )
+        {
+            delete clause;
+            return true;
+        }
+        if( solver.isUndefined( lit ) )
+            clause->setAt( j++, lit );
+    }
+    clause->shrink( j );
+    return solver.addClauseRuntime( clause );
+}
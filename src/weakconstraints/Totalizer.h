@@ -0,0 +1,64 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+#ifndef TOTALIZER_H
+#define TOTALIZER_H
+
+#include <vector>
+using namespace std;
+#include "../Literal.h"
+
+class Clause;
+class WeakInterface;
+
+/*
+ * Incremental totalizer: the j-th output of a node is true when at least j
+ * inputs below the node are true. Outputs are created up to the current
+ * bound only, and the bound is extended on demand.
+ */
+class Totalizer
+{
+    public:
+        Totalizer( WeakInterface& weakInterface, const vector< Literal >& inputs );
+
+        bool extend( unsigned int bound );
+
+        inline unsigned int getBound() const { return nodes[ root ].outputs.size(); }
+        inline unsigned int numberOfInputs() const { return nodes[ root ].leaves; }
+        inline Literal getOutput( unsigned int j ) const { assert( j >= 1 && j <= getBound() ); return nodes[ root ].outputs[ j - 1 ]; }
+
+    private:
+        class Node
+        {
+            public:
+                Node( unsigned int l, unsigned int r, unsigned int n ) : left( l ), right( r ), leaves( n ) {}
+                unsigned int left;
+                unsigned int right;
+                unsigned int leaves;
+                vector< Literal > outputs;
+        };
+
+        WeakInterface& weakInterface;
+        vector< Node > nodes;
+        unsigned int root;
+
+        unsigned int createNode( const vector< Literal >& inputs, unsigned int begin, unsigned int end );
+        bool extendNode( unsigned int node, unsigned int bound );
+        bool addClause( Clause* clause );
+};
+
+#endif
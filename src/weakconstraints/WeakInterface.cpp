@@ -17,11 +17,17 @@
  */
 
 #include "WeakInterface.h"
+#include "LocalSearch.h"
 
 unsigned int WeakInterface::level_ = 0;
 uint64_t WeakInterface::lb_ = 0;
 uint64_t WeakInterface::ub_ = UINT64_MAX;
 
+WeakInterface::~WeakInterface()
+{
+    delete localSearch;
+}
+
 bool
 WeakInterface::createFalseAggregate(
     const vector< Literal >& literals,
@@ -240,6 +246,9 @@ WeakInterface::solve()
         solver.clearConflictStatus();
     }
     
+    if( wasp::Options::localSearchFlips > 0 )
+        localSearch = new LocalSearch( solver );
+
     unsigned int res = OPTIMUM_FOUND;
     for( int i = solver.numberOfLevels() - 1; i >= 0; i-- )
     {
@@ -247,6 +256,7 @@ WeakInterface::solve()
         lb_ = solver.simplifyOptimizationLiterals( level() );
         ub_ = UINT64_MAX;
         trace_msg( weakconstraints, 1, "Solving level " << level() << ": lb=" << lb_ << ", ub=" << ub_ );                
+        runLocalSearch();
         
         res = run();
         if( res == INCOHERENT )
@@ -287,6 +297,95 @@ WeakInterface::hardening()
     return true;
 }
 
+void
+WeakInterface::trimCore()
+{
+    assert( solver.getUnsatCore() != NULL );
+    while( solver.getUnsatCore()->size() > 1 )
+    {
+        const Clause& unsatCore = *( solver.getUnsatCore() );
+        unsigned int size = unsatCore.size();
+        trace_msg( weakconstraints, 2, "Trimming unsat core of size " << size );
+
+        Clause* core = new Clause( size );
+        vector< Literal > coreAssumptions;
+        for( unsigned int i = 0; i < size; i++ )
+        {
+            core->addLiteral( unsatCore[ i ] );
+            coreAssumptions.push_back( unsatCore[ i ].getOppositeLiteral() );
+        }
+
+        //The solver replaces its core: the old one is restored if the new one is not smaller.
+        if( solveWithBudget( coreAssumptions ) != INCOHERENT || solver.getUnsatCore() == NULL || solver.getUnsatCore()->size() >= size )
+        {
+            solver.setUnsatCore( core );
+            return;
+        }
+        delete core;
+    }
+}
+
+bool
+WeakInterface::exhaustBound(
+    Literal bound,
+    bool& exhausted )
+{
+    trace_msg( weakconstraints, 2, "Exhausting bound " << bound );
+    vector< Literal > boundAssumptions;
+    boundAssumptions.push_back( bound );
+    exhausted = ( solveWithBudget( boundAssumptions ) == INCOHERENT );
+    if( !exhausted )
+        return true;
+
+    //The bound cannot hold: the cost of its optimization literal is paid in every answer set.
+    Literal lit = bound.getOppositeLiteral();
+    for( unsigned int i = 0; i < solver.numberOfOptimizationLiterals( level() ); i++ )
+    {
+        OptimizationLiteralData& optLitData = solver.getOptimizationLiteral( level(), i );
+        if( optLitData.isRemoved() || optLitData.lit != lit )
+            continue;
+        incrementLb( optLitData.weight );
+        optLitData.remove();
+    }
+    solver.foundLowerBound( lb() );
+    return solver.addClauseRuntime( lit );
+}
+
+unsigned int
+WeakInterface::solveWithBudget(
+    vector< Literal >& coreAssumptions )
+{
+    solver.clearConflictStatus();
+    solver.unrollToZero();
+    solver.setMaxNumberOfConflicts( solver.getNumberOfConflicts() + wasp::Options::coreBudget );
+    unsigned int result = solver.solve( coreAssumptions );
+    solver.setMaxNumberOfConflicts( UINT64_MAX );
+    solver.clearConflictStatus();
+    solver.unrollToZero();
+    return result;
+}
+
+void
+WeakInterface::runLocalSearch()
+{
+    if( localSearch == NULL )
+        return;
+
+    assert( solver.getCurrentDecisionLevel() == 0 );
+    if( !localSearch->run( level(), wasp::Options::localSearchFlips ) )
+        return;
+
+    //The assignment of local search is now the phase of the solver: a few conflicts should repair it into an answer set.
+    solver.setMaxNumberOfConflicts( solver.getNumberOfConflicts() + wasp::Options::coreBudget );
+    unsigned int result = solver.solve();
+    solver.setMaxNumberOfConflicts( UINT64_MAX );
+    trace_msg( weakconstraints, 2, "Repair of local search assignment: " << ( result == COHERENT ? "answer set" : "no answer set" ) );
+    if( result == COHERENT )
+        foundAnswerSet( solver.computeCostOfModel( level() ) );
+    solver.unrollToZero();
+    solver.clearConflictStatus();
+}
+
 void
 WeakInterface::foundAnswerSet(
     uint64_t cost )
@@ -27,11 +27,15 @@ using namespace std;
 #include "../Literal.h"
 #include "../Solver.h"
 
+class LocalSearch;
+
 class WeakInterface
 {
+    friend class Totalizer;
+
     public:
-        WeakInterface( Solver& s ) : solver( s ), numberOfCalls( 0 ), disjCoresPreprocessing( false ), mixedApproach( false ), weight( UINT64_MAX ) {}
-        virtual ~WeakInterface() {}
+        WeakInterface( Solver& s ) : solver( s ), numberOfCalls( 0 ), disjCoresPreprocessing( false ), mixedApproach( false ), localSearch( NULL ), weight( UINT64_MAX ) {}
+        virtual ~WeakInterface();
         unsigned int solve();        
         
         inline void setDisjCoresPreprocessing( bool value ) { disjCoresPreprocessing = value; }
@@ -58,6 +62,11 @@ class WeakInterface
         inline void computeAssumptionsStratified();
         inline bool changeWeight();
         bool hardening();
+        void trimCore();
+        bool exhaustBound( Literal bound, bool& exhausted );
+        unsigned int solveWithBudget( vector< Literal >& coreAssumptions );
+        void runLocalSearch();
+        inline void runLocalSearchPeriodically() { if( localSearch != NULL && numberOfCalls % wasp::Options::localSearchPeriod == 0 ) runLocalSearch(); }
         
         virtual void foundAnswerSet( uint64_t cost );        
         virtual bool foundUnsat() { return true; }
@@ -77,6 +86,7 @@ class WeakInterface
         bool mixedApproach;
 
     private:
+        LocalSearch* localSearch;
         vector< uint64_t > weights;        
         uint64_t weight;        
         
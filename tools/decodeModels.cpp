@@ -0,0 +1,92 @@
+/*
+ *
+ *  Copyright 2013 Mario Alviano, Carmine Dodaro, and Francesco Ricca.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+/*
+ * Decodes the stream written by dwasp --binary-output.
+ * Models are printed as by the default output, one per line.
+ * With --count only the number of models is printed.
+ */
+
+#include "../src/outputBuilders/BinaryModelReader.h"
+
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+int main( int argc, char** argv )
+{
+    bool count = argc > 1 && strcmp( argv[ 1 ], "--count" ) == 0;
+    BinaryModelReader reader( stdin );
+    if( !reader.readHeader() )
+    {
+        cerr << "Not a binary model stream." << endl;
+        return 1;
+    }
+
+    uint64_t numberOfModels = 0;
+    string line;
+    for( int tag = reader.next(); tag != BINARY_END; tag = reader.next() )
+    {
+        switch( tag )
+        {
+            case BINARY_FULL_MODEL:
+            case BINARY_DELTA_MODEL:
+                numberOfModels++;
+                if( count )
+                    break;
+                line = "{";
+                for( unsigned int i = 0; i < reader.numberOfAtoms(); i++ )
+                {
+                    if( !reader.isTrue( i ) )
+                        continue;
+                    if( line.size() > 1 )
+                        line += ", ";
+                    line += reader.getName( i );
+                }
+                line += "}\n";
+                fwrite( line.data(), 1, line.size(), stdout );
+                break;
+
+            case BINARY_COST:
+                if( count )
+                    break;
+                cout << "COST";
+                for( unsigned int i = 0; i < reader.getCosts().size(); i++ )
+                    cout << " " << reader.getCosts()[ i ] << "@" << ( reader.getCosts().size() - i );
+                cout << endl;
+                break;
+
+            case BINARY_LOWER_BOUND:
+                break;
+
+            case BINARY_OPTIMUM:
+                if( !count )
+                    cout << "OPTIMUM" << endl;
+                break;
+
+            case BINARY_INCOHERENT:
+                if( !count )
+                    cout << "INCOHERENT" << endl;
+                break;
+        }
+    }
+
+    if( count )
+        cout << numberOfModels << endl;
+    return 0;
+}